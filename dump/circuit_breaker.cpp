@@ -0,0 +1,55 @@
+#include "circuit_breaker.hpp"
+
+#include <algorithm>
+
+namespace openpower::dump
+{
+
+CircuitBreaker::CircuitBreaker(std::chrono::milliseconds minBackoff,
+                               std::chrono::milliseconds maxBackoff) :
+    _minBackoff(minBackoff),
+    _maxBackoff(maxBackoff)
+{}
+
+bool CircuitBreaker::isOpen() const
+{
+    switch (_state)
+    {
+        case State::closed:
+            return false;
+        case State::open:
+            return std::chrono::steady_clock::now() < _retryAt;
+        case State::probing:
+            return true;
+    }
+    return false;
+}
+
+void CircuitBreaker::attempt()
+{
+    if (_state == State::open)
+    {
+        _state = State::probing;
+    }
+}
+
+void CircuitBreaker::success()
+{
+    _state = State::closed;
+    _backoff = std::chrono::milliseconds(0);
+}
+
+void CircuitBreaker::failure()
+{
+    if (_backoff.count() == 0)
+    {
+        _backoff = _minBackoff;
+    }
+    else
+    {
+        _backoff = std::min(_backoff * 2, _maxBackoff);
+    }
+    _state = State::open;
+    _retryAt = std::chrono::steady_clock::now() + _backoff;
+}
+} // namespace openpower::dump
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+
+namespace openpower::dump
+{
+
+/**
+ * @class CircuitBreaker
+ * @brief Stop using a failing transport and probe it with backoff
+ * @details Circuit opens on a failure, no request is sent until the backoff
+ *  expires, then a single probe request is allowed. Success of the probe
+ *  closes the circuit, failure opens it again with the backoff doubled up
+ *  to the maximum.
+ */
+class CircuitBreaker
+{
+  public:
+    CircuitBreaker() = delete;
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+    CircuitBreaker(CircuitBreaker&&) = delete;
+    CircuitBreaker& operator=(CircuitBreaker&&) = delete;
+    virtual ~CircuitBreaker() = default;
+
+    /** @brief State of the circuit */
+    enum class State
+    {
+        closed,
+        open,
+        probing
+    };
+
+    /**
+     * @brief Constructor
+     * @param[in] minBackoff - backoff after the first failure
+     * @param[in] maxBackoff - limit of the backoff
+     */
+    CircuitBreaker(std::chrono::milliseconds minBackoff,
+                   std::chrono::milliseconds maxBackoff);
+
+    /**
+     * @brief Check if requests are to be held back
+     * @return true if open and the backoff is not expired or a probe is in
+     *         progress
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Request is being sent, it is the probe if the circuit is open
+     */
+    void attempt();
+
+    /**
+     * @brief Request succeeded, close the circuit
+     */
+    void success();
+
+    /**
+     * @brief Request failed on the transport, open the circuit
+     */
+    void failure();
+
+    /**
+     * @brief Get the state of the circuit
+     * @return state of the circuit
+     */
+    State getState() const
+    {
+        return _state;
+    }
+
+    /**
+     * @brief Get the backoff before the next probe
+     * @return backoff applied on the last failure
+     */
+    std::chrono::milliseconds getBackoff() const
+    {
+        return _backoff;
+    }
+
+  private:
+    /** @brief backoff after the first failure */
+    const std::chrono::milliseconds _minBackoff;
+
+    /** @brief limit of the backoff */
+    const std::chrono::milliseconds _maxBackoff;
+
+    /** @brief backoff applied on the last failure */
+    std::chrono::milliseconds _backoff{0};
+
+    /** @brief state of the circuit */
+    State _state = State::closed;
+
+    /** @brief time after which the probe is allowed */
+    std::chrono::steady_clock::time_point _retryAt{};
+};
+} // namespace openpower::dump
@@ -2,9 +2,18 @@
 
 #include "dbus_util.hpp"
 
+#include "logging.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
 namespace openpower::dump
 {
-using ::openpower::dump::utility::DbusVariantType;
+using ::openpower::dump::logging::logMsg;
 
 bool isDumpProgressCompleted(sdbusplus::bus::bus& bus,
                              const std::string& objectPath)
@@ -24,10 +33,9 @@ bool isDumpProgressCompleted(sdbusplus::bus::bus& bus,
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("Util failed to get dump ({}) progress property ({})",
-                        objectPath, ex.what())
-                .c_str());
+        logMsg<level::ERR>("Util failed to get dump ({}) progress property "
+                           "({})",
+                           objectPath, ex.what());
         throw;
     }
     return false;
@@ -35,21 +43,79 @@ bool isDumpProgressCompleted(sdbusplus::bus::bus& bus,
 
 bool isDumpProgressCompleted(const DBusPropertiesMap& propMap)
 {
-    for (auto prop : propMap)
+    auto prop = propMap.find("Status");
+    if (prop != propMap.end())
+    {
+        return isDumpProgressCompleted(prop->second);
+    }
+    return false;
+}
+
+bool isDumpProgressCompleted(const DbusVariantType& status)
+{
+    auto value = std::get_if<std::string>(&status);
+    return value != nullptr && *value == progressComplete;
+}
+
+bool isDumpOffloaded(const DBusPropertiesMap& propMap)
+{
+    auto prop = propMap.find("Offloaded");
+    if (prop != propMap.end())
+    {
+        return isDumpOffloaded(prop->second);
+    }
+    return false;
+}
+
+bool isDumpOffloaded(const DbusVariantType& offloaded)
+{
+    auto value = std::get_if<bool>(&offloaded);
+    return value != nullptr && *value;
+}
+
+uint64_t getDumpSize(const DBusPropertiesMap& propMap)
+{
+    auto prop = propMap.find("Size");
+    if (prop == propMap.end())
     {
-        if (prop.first == "Status")
+        return 0;
+    }
+    auto value = std::get_if<uint64_t>(&prop->second);
+    return value != nullptr ? *value : 0;
+}
+
+std::optional<DbusVariantType>
+    readChangedProperty(sdbusplus::message::message& msg,
+                        const std::string& prop)
+{
+    auto check = [](int rc) {
+        if (rc < 0)
         {
-            auto status = std::get_if<std::string>(&prop.second);
-            if (status != nullptr)
-            {
-                if (*status == progressComplete)
-                {
-                    return true;
-                }
-            }
+            throw std::runtime_error(fmt::format(
+                "Util failed to decode changed properties ({})",
+                strerror(-rc)));
+        }
+        return rc;
+    };
+    auto* m = msg.get();
+    // interface name is matched by the signal match rule
+    check(sd_bus_message_skip(m, "s"));
+    check(sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sv}"));
+    while (check(sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                                "sv")) > 0)
+    {
+        const char* name = nullptr;
+        check(sd_bus_message_read(m, "s", &name));
+        if (prop == name)
+        {
+            DbusVariantType value;
+            msg.read(value);
+            return value;
         }
+        check(sd_bus_message_skip(m, "v"));
+        check(sd_bus_message_exit_container(m));
     }
-    return false;
+    return std::nullopt;
 }
 
 uint64_t getDumpSize(sdbusplus::bus::bus& bus, const std::string& objectPath)
@@ -64,81 +130,176 @@ uint64_t getDumpSize(sdbusplus::bus::bus& bus, const std::string& objectPath)
         {
             std::string err = fmt::format(
                 "Util size value not set for dump object ({})", objectPath);
-            log<level::ERR>(err.c_str());
+            logMsg<level::ERR>("{}", err);
             throw std::runtime_error(err);
         }
         size = *sizePtr;
     }
     catch (const std::exception& ex)
     {
-        log<level::INFO>(
-            fmt::format(
-                "Util failed to get dump size property object ({}) ex({})",
-                objectPath, ex.what())
-                .c_str());
+        logMsg<level::INFO>("Util failed to get dump size property object ({}) "
+                            "ex({})",
+                            objectPath, ex.what());
         throw;
     }
     return size;
 }
 
-bool isSystemHMCManaged(sdbusplus::bus::bus& bus)
+namespace
 {
-    using BiosBaseTableItem = std::pair<
-        std::string,
-        std::tuple<std::string, bool, std::string, std::string, std::string,
-                   std::variant<int64_t, std::string>,
-                   std::variant<int64_t, std::string>,
-                   std::vector<std::tuple<
-                       std::string, std::variant<int64_t, std::string>>>>>;
-    using BiosBaseTable = std::vector<BiosBaseTableItem>;
+using BiosBaseTableItem = std::pair<
+    std::string,
+    std::tuple<std::string, bool, std::string, std::string, std::string,
+               std::variant<int64_t, std::string>,
+               std::variant<int64_t, std::string>,
+               std::vector<std::tuple<std::string,
+                                      std::variant<int64_t, std::string>>>>>;
+using BiosBaseTable = std::vector<BiosBaseTableItem>;
 
-    try
+/**
+ * @brief Check the pvm_hmc_managed attribute in the BaseBIOSTable value
+ * @param[in] retVal BaseBIOSTable property value
+ * @return true if HMC managed else false
+ */
+bool isHMCManagedAttrSet(const std::variant<BiosBaseTable>& retVal)
+{
+    std::string hmcManaged{};
+    const auto baseBiosTable = std::get_if<BiosBaseTable>(&retVal);
+    if (baseBiosTable == nullptr)
     {
-        std::string hmcManaged{};
-        auto retVal = readDBusProperty<std::variant<BiosBaseTable>>(
-            bus, "xyz.openbmc_project.BIOSConfigManager",
-            "/xyz/openbmc_project/bios_config/manager",
-            "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
-        const auto baseBiosTable = std::get_if<BiosBaseTable>(&retVal);
-        if (baseBiosTable == nullptr)
+        logMsg<level::ERR>(
+            "Util failed to read BIOSconfig property BaseBIOSTable");
+        return false;
+    }
+    for (const auto& item : *baseBiosTable)
+    {
+        std::string attributeName = std::get<0>(item);
+        auto attrValue = std::get<5>(std::get<1>(item));
+        auto val = std::get_if<std::string>(&attrValue);
+        if (val != nullptr && attributeName == "pvm_hmc_managed")
         {
-            log<level::ERR>(
-                "Util failed to read BIOSconfig property BaseBIOSTable");
-            return false;
+            hmcManaged = *val;
+            break;
         }
-        for (const auto& item : *baseBiosTable)
-        {
-            std::string attributeName = std::get<0>(item);
-            auto attrValue = std::get<5>(std::get<1>(item));
-            auto val = std::get_if<std::string>(&attrValue);
-            if (val != nullptr && attributeName == "pvm_hmc_managed")
+    }
+    if (hmcManaged.empty())
+    {
+        logMsg<level::ERR>(
+            "Util failed to read pvm_hmc_managed property value");
+        return false;
+    }
+    if (hmcManaged == "Enabled")
+    {
+        logMsg<level::INFO>("Util system is HMC managed");
+        return true;
+    }
+    logMsg<level::INFO>("Util system is not HMC managed");
+    return false;
+}
+
+/**
+ * @brief Check if the BootProgress value indicates host is running
+ * @param[in] retVal BootProgress property value
+ * @return true if host is running else false
+ */
+bool isHostRunningProgress(const DBusProgressValue_t& retVal)
+{
+    const std::string* progPtr = std::get_if<std::string>(&retVal);
+    if (progPtr == nullptr)
+    {
+        logMsg<level::ERR>(
+            "Util BootProgress value not set for host state object");
+        return false;
+    }
+
+    ProgressStages bootProgess = sdbusplus::xyz::openbmc_project::State::Boot::
+        server::Progress::convertProgressStagesFromString(*progPtr);
+    if ((bootProgess == ProgressStages::SystemInitComplete) ||
+        (bootProgess == ProgressStages::OSStart) ||
+        (bootProgess == ProgressStages::OSRunning))
+    {
+        logMsg<level::INFO>("Util host is in running state");
+        return true;
+    }
+    logMsg<level::INFO>("Util host is not in running state");
+    return false;
+}
+
+constexpr auto biosConfigService = "xyz.openbmc_project.BIOSConfigManager";
+constexpr auto biosConfigObjPath = "/xyz/openbmc_project/bios_config/manager";
+constexpr auto biosConfigIntf = "xyz.openbmc_project.BIOSConfig.Manager";
+constexpr auto hostStateService = "xyz.openbmc_project.State.Host";
+constexpr auto hostStateObjPath = "/xyz/openbmc_project/state/host0";
+constexpr auto bootProgressIntf = "xyz.openbmc_project.State.Boot.Progress";
+constexpr auto chassisStateService = "xyz.openbmc_project.State.Chassis";
+constexpr auto chassisStateObjPath = "/xyz/openbmc_project/state/chassis0";
+constexpr auto chassisStateIntf = "xyz.openbmc_project.State.Chassis";
+
+/**
+ * @brief Send a non blocking property get request
+ * @param[in] bus D-Bus handle
+ * @param[in] service service which has implemented the interface
+ * @param[in] object object having has implemented the interface
+ * @param[in] intf interface having the property
+ * @param[in] prop name of the property to read
+ * @param[in] callback invoked with the property value, nullopt on error
+ * @return slot of the pending call
+ */
+template <typename T>
+sdbusplus::slot_t
+    asyncReadDBusProperty(sdbusplus::bus::bus& bus, const std::string& service,
+                          const std::string& object, const std::string& intf,
+                          const std::string& prop,
+                          std::function<void(std::optional<T>)> callback)
+{
+    auto method = bus.new_method_call(service.c_str(), object.c_str(),
+                                      dbusPropIntf, "Get");
+    method.append(intf);
+    method.append(prop);
+    return bus.call_async(
+        method, [prop, callback = std::move(callback)](
+                    sdbusplus::message::message& reply) {
+            std::optional<T> retVal;
+            try
             {
-                hmcManaged = *val;
-                break;
+                if (reply.is_method_error())
+                {
+                    logMsg<level::ERR>("Util async read of property ({}) "
+                                       "failed errno ({})",
+                                       prop, reply.get_errno());
+                }
+                else
+                {
+                    T value{};
+                    reply.read(value);
+                    retVal = std::move(value);
+                }
             }
-        }
-        if (hmcManaged.empty())
-        {
-            log<level::ERR>(
-                "Util failed to read pvm_hmc_managed property value");
-            return false;
-        }
-        if (hmcManaged == "Enabled")
-        {
-            log<level::INFO>("Util system is HMC managed");
-            return true;
-        }
+            catch (const std::exception& ex)
+            {
+                logMsg<level::ERR>("Util failed to decode property ({}) ({})",
+                                   prop, ex.what());
+            }
+            callback(std::move(retVal));
+        });
+}
+} // namespace
+
+bool isSystemHMCManaged(sdbusplus::bus::bus& bus)
+{
+    try
+    {
+        auto retVal = readDBusProperty<std::variant<BiosBaseTable>>(
+            bus, biosConfigService, biosConfigObjPath, biosConfigIntf,
+            "BaseBIOSTable");
+        return isHMCManagedAttrSet(retVal);
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("Util Failed to read pvm_hmc_managed property ({})",
-                        ex.what())
-                .c_str());
-        return false;
+        logMsg<level::ERR>("Util Failed to read pvm_hmc_managed property ({})",
+                           ex.what());
     }
-
-    log<level::INFO>("Util system is not HMC managed");
+    logMsg<level::INFO>("Util system is not HMC managed");
     return false;
 }
 
@@ -146,38 +307,17 @@ bool isHostRunning(sdbusplus::bus::bus& bus)
 {
     try
     {
-        constexpr auto hostStateObjPath = "/xyz/openbmc_project/state/host0";
         auto retVal = readDBusProperty<DBusProgressValue_t>(
-            bus, "xyz.openbmc_project.State.Host", hostStateObjPath,
-            "xyz.openbmc_project.State.Boot.Progress", "BootProgress");
-        const std::string* progPtr = std::get_if<std::string>(&retVal);
-        if (progPtr == nullptr)
-        {
-            std::string err = fmt::format(
-                "Util BootProgress value not set for host state object ({})",
-                hostStateObjPath);
-            log<level::ERR>(err.c_str());
-            return false;
-        }
-
-        ProgressStages bootProgess = sdbusplus::xyz::openbmc_project::State::
-            Boot::server::Progress::convertProgressStagesFromString(*progPtr);
-        if ((bootProgess == ProgressStages::SystemInitComplete) ||
-            (bootProgess == ProgressStages::OSStart) ||
-            (bootProgess == ProgressStages::OSRunning))
-        {
-            log<level::INFO>("Util host is in running state");
-            return true;
-        }
+            bus, hostStateService, hostStateObjPath, bootProgressIntf,
+            "BootProgress");
+        return isHostRunningProgress(retVal);
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("Util failed to read BootProgress property ({})",
-                        ex.what())
-                .c_str());
+        logMsg<level::ERR>("Util failed to read BootProgress property ({})",
+                           ex.what());
     }
-    log<level::INFO>("Util host is not in running state");
+    logMsg<level::INFO>("Util host is not in running state");
     return false;
 }
 
@@ -198,21 +338,121 @@ const std::vector<std::string>
         mapperCall.append(intf);
         auto response = bus.call(mapperCall);
         response.read(liObjectPaths);
-        log<level::INFO>(
-            fmt::format("Util dumps size received is ({}) entry({})",
-                        liObjectPaths.size(), entryIntf)
-                .c_str());
+        logMsg<level::INFO>("Util dumps size received is ({}) entry({})",
+                            liObjectPaths.size(), entryIntf);
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format(
-                "Util failed to get dump entry objects entry({}) ex({})",
-                entryIntf, ex.what())
-                .c_str());
+        logMsg<level::ERR>("Util failed to get dump entry objects entry({}) "
+                           "ex({})",
+                           entryIntf, ex.what());
         throw;
     }
     return liObjectPaths;
 }
 
+sdbusplus::slot_t asyncIsSystemHMCManaged(sdbusplus::bus::bus& bus,
+                                          AsyncStateCallback callback)
+{
+    return asyncReadDBusProperty<std::variant<BiosBaseTable>>(
+        bus, biosConfigService, biosConfigObjPath, biosConfigIntf,
+        "BaseBIOSTable",
+        [callback = std::move(callback)](auto retVal) {
+            if (!retVal)
+            {
+                logMsg<level::INFO>("Util system is not HMC managed");
+                callback(false);
+                return;
+            }
+            callback(isHMCManagedAttrSet(*retVal));
+        });
+}
+
+sdbusplus::slot_t asyncIsHostRunning(sdbusplus::bus::bus& bus,
+                                     AsyncStateCallback callback)
+{
+    return asyncReadDBusProperty<DBusProgressValue_t>(
+        bus, hostStateService, hostStateObjPath, bootProgressIntf,
+        "BootProgress", [callback = std::move(callback)](auto retVal) {
+            if (!retVal)
+            {
+                logMsg<level::INFO>("Util host is not in running state");
+                callback(false);
+                return;
+            }
+            callback(isHostRunningProgress(*retVal));
+        });
+}
+
+sdbusplus::slot_t asyncGetPowerStateChangeTime(sdbusplus::bus::bus& bus,
+                                               AsyncTimeCallback callback)
+{
+    return asyncReadDBusProperty<std::variant<uint64_t>>(
+        bus, chassisStateService, chassisStateObjPath, chassisStateIntf,
+        "LastStateChangeTime", [callback = std::move(callback)](auto retVal) {
+            if (!retVal)
+            {
+                callback(std::nullopt);
+                return;
+            }
+            callback(std::get<uint64_t>(*retVal));
+        });
+}
+
+sdbusplus::slot_t asyncGetDumpEntryObjects(sdbusplus::bus::bus& bus,
+                                           AsyncDumpObjectsCallback callback)
+{
+    auto method = bus.new_method_call(dumpService, dumpObjPath,
+                                      dbusObjManagerIntf, "GetManagedObjects");
+    return bus.call_async(method, [callback = std::move(callback)](
+                                      sdbusplus::message::message& reply) {
+        ManagedObjectType objects;
+        int error = 0;
+        try
+        {
+            if (reply.is_method_error())
+            {
+                error = -reply.get_errno();
+                logMsg<level::ERR>("Util failed to get dump entry objects "
+                                   "errno ({})",
+                                   reply.get_errno());
+            }
+            else
+            {
+                reply.read(objects);
+                logMsg<level::INFO>("Util dump objects received is ({})",
+                                    objects.size());
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            error = -EBADMSG;
+            logMsg<level::ERR>("Util failed to decode dump entry objects ({})",
+                               ex.what());
+        }
+        callback(error, objects);
+    });
+}
+
+sdbusplus::slot_t asyncGetDumpSize(sdbusplus::bus::bus& bus,
+                                   const std::string& objectPath,
+                                   AsyncDumpSizeCallback callback)
+{
+    return asyncReadDBusProperty<DbusVariantType>(
+        bus, dumpService, objectPath, entryIntf, "Size",
+        [objectPath, callback = std::move(callback)](auto retVal) {
+            const uint64_t* size =
+                retVal ? std::get_if<uint64_t>(&*retVal) : nullptr;
+            if (size == nullptr)
+            {
+                logMsg<level::ERR>("Util size value not read for dump "
+                                   "object ({})",
+                                   objectPath);
+                callback(std::nullopt);
+                return;
+            }
+            callback(*size);
+        });
+}
+
 } // namespace openpower::dump
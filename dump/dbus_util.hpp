@@ -1,16 +1,22 @@
 #pragma once
 
+#include "logging.hpp"
 #include "utility.hpp"
 
 #include <fmt/format.h>
 
 #include <cstdint>
+#include <functional>
+#include <optional>
 #include <phosphor-logging/log.hpp>
+#include <sdbusplus/slot.hpp>
 #include <xyz/openbmc_project/State/Boot/Progress/server.hpp>
 
 namespace openpower::dump
 {
+using ::openpower::dump::utility::DbusVariantType;
 using ::openpower::dump::utility::DBusPropertiesMap;
+using ::openpower::dump::utility::ManagedObjectType;
 using ::phosphor::logging::level;
 using ::phosphor::logging::log;
 using ::sdbusplus::message::object_path;
@@ -28,6 +34,47 @@ using DBusProgressValue_t =
  */
 bool isDumpProgressCompleted(const DBusPropertiesMap& propMap);
 
+/**
+ * @brief Check the value of the progress Status property
+ * @param[in] status Status property value
+ * @return true if progress is complete else false
+ */
+bool isDumpProgressCompleted(const DbusVariantType& status);
+
+/**
+ * @brief Read offloaded property from the entry interface properties
+ * @param[in] propMap map of properties and its values
+ * @return true if dump is offloaded else false
+ */
+bool isDumpOffloaded(const DBusPropertiesMap& propMap);
+
+/**
+ * @brief Check the value of the entry Offloaded property
+ * @param[in] offloaded Offloaded property value
+ * @return true if dump is offloaded else false
+ */
+bool isDumpOffloaded(const DbusVariantType& offloaded);
+
+/**
+ * @brief Read size property from the entry interface properties
+ * @param[in] propMap map of properties and its values
+ * @return size of the dump, 0 if not set
+ */
+uint64_t getDumpSize(const DBusPropertiesMap& propMap);
+
+/**
+ * @brief Read a single property from a PropertiesChanged signal
+ * @detail The changed properties are scanned by name and only the value of
+ *         the requested property is decoded, the values of the other
+ *         properties are skipped in place without being decoded.
+ * @param[in] msg PropertiesChanged signal
+ * @param[in] prop name of the property to read
+ * @return property value, nullopt if the property is not in the signal
+ */
+std::optional<DbusVariantType>
+    readChangedProperty(sdbusplus::message::message& msg,
+                        const std::string& prop);
+
 /**
  * @brief Read progress property from the D-Bus object
  * @param[in] bus - D-Bus handle
@@ -81,11 +128,9 @@ T readDBusProperty(sdbusplus::bus::bus& bus, const std::string& service,
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("Failed to get the property ({}) interface ({}) "
-                        "object path ({}) error ({}) ",
-                        prop.c_str(), intf.c_str(), object.c_str(), ex.what())
-                .c_str());
+        logging::logMsg<level::ERR>("Failed to get the property ({}) interface "
+                                    "({}) object path ({}) error ({}) ",
+                                    prop, intf, object, ex.what());
         throw;
     }
     return retVal;
@@ -108,4 +153,86 @@ bool isHostRunning(sdbusplus::bus::bus& bus);
 const std::vector<std::string>
     getDumpEntryObjPaths(sdbusplus::bus::bus& bus,
                          const std::string& entryIntf);
+
+/**
+ * @brief Callback type for the asynchronous state reads
+ * @param[in] state - value read, false if the read failed
+ */
+using AsyncStateCallback = std::function<void(bool state)>;
+
+/**
+ * @brief Callback type for the asynchronous dump entries read
+ * @param[in] error - 0 on success else negative errno of the failure
+ * @param[in] objects - dump objects and their interfaces and properties
+ */
+using AsyncDumpObjectsCallback =
+    std::function<void(int error, const ManagedObjectType& objects)>;
+
+/**
+ * @brief Callback type for the asynchronous dump size read
+ * @param[in] size - size of the dump, nullopt if the read failed
+ */
+using AsyncDumpSizeCallback = std::function<void(std::optional<uint64_t>)>;
+
+/**
+ * @brief Callback type for the asynchronous time reads
+ * @param[in] time - milliseconds since the Unix epoch, nullopt if the read
+ *                   failed
+ */
+using AsyncTimeCallback = std::function<void(std::optional<uint64_t>)>;
+
+/**
+ * @brief Asynchronously check if system is HMC managed
+ * @detail Non blocking version of isSystemHMCManaged, request is sent and
+ *         the callback is invoked from the event loop when reply arrives.
+ * @param[in] bus D-Bus handle
+ * @param[in] callback invoked with true if HMC managed else false
+ * @return slot of the pending call, call is cancelled if slot is released
+ */
+sdbusplus::slot_t asyncIsSystemHMCManaged(sdbusplus::bus::bus& bus,
+                                          AsyncStateCallback callback);
+
+/**
+ * @brief Asynchronously check if host is in running state
+ * @detail Non blocking version of isHostRunning
+ * @param[in] bus D-Bus handle
+ * @param[in] callback invoked with true if host is running else false
+ * @return slot of the pending call, call is cancelled if slot is released
+ */
+sdbusplus::slot_t asyncIsHostRunning(sdbusplus::bus::bus& bus,
+                                     AsyncStateCallback callback);
+
+/**
+ * @brief Asynchronously read the time the chassis was last powered on or
+ *        off, the power on time of the host while it is running
+ * @param[in] bus D-Bus handle
+ * @param[in] callback invoked with the time of the last power state change
+ * @return slot of the pending call, call is cancelled if slot is released
+ */
+sdbusplus::slot_t asyncGetPowerStateChangeTime(sdbusplus::bus::bus& bus,
+                                               AsyncTimeCallback callback);
+
+/**
+ * @brief Asynchronously read all the dump entries along with their
+ *        properties from the dump manager in a single request
+ * @detail Replaces the per dump type mapper lookup and per dump progress
+ *         property reads done at startup.
+ * @param[in] bus D-Bus handle
+ * @param[in] callback invoked with the dump objects
+ * @return slot of the pending call, call is cancelled if slot is released
+ */
+sdbusplus::slot_t asyncGetDumpEntryObjects(sdbusplus::bus::bus& bus,
+                                           AsyncDumpObjectsCallback callback);
+
+/**
+ * @brief Asynchronously read the size of a dump
+ * @detail Non blocking version of getDumpSize
+ * @param[in] bus D-Bus handle
+ * @param[in] objectPath path of the D-Bus entry object
+ * @param[in] callback invoked with the size of the dump
+ * @return slot of the pending call, call is cancelled if slot is released
+ */
+sdbusplus::slot_t asyncGetDumpSize(sdbusplus::bus::bus& bus,
+                                   const std::string& objectPath,
+                                   AsyncDumpSizeCallback callback);
 } // namespace openpower::dump
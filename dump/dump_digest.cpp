@@ -0,0 +1,135 @@
+#include "config.h"
+
+#include "dump_digest.hpp"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+
+#ifdef DUMP_DEDUP
+#include <xxhash.h>
+#endif
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+DumpDigest::DumpDigest(WorkerPool& workerPool, Callback callback) :
+    _workerPool(workerPool), _callback(std::move(callback))
+{
+    _recentDigests.reserve(recentDigestCount);
+}
+
+bool DumpDigest::isEnabled() const
+{
+#ifdef DUMP_DEDUP
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DumpDigest::hash(const DumpKey& key)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    auto digest = std::make_shared<std::optional<uint64_t>>();
+    ++_pendingCount;
+    _workerPool.post(
+        [key, digest]() {
+            auto path = getDumpFilePath(key);
+            if (path)
+            {
+                *digest = computeDigest(*path);
+            }
+        },
+        [this, key, digest]() {
+            --_pendingCount;
+            if (!*digest)
+            {
+                logMsg<level::DEBUG>("Digest dump file not read id ({}) "
+                                     "type ({})",
+                                     key.id, key.type);
+            }
+            _callback(key, *digest);
+        });
+}
+
+bool DumpDigest::isRecentlyOffloaded(uint64_t digest) const
+{
+    return std::find(_recentDigests.begin(), _recentDigests.end(), digest) !=
+           _recentDigests.end();
+}
+
+void DumpDigest::offloaded(uint64_t digest)
+{
+    if (!isEnabled() || isRecentlyOffloaded(digest))
+    {
+        return;
+    }
+    if (_recentDigests.size() < static_cast<size_t>(recentDigestCount))
+    {
+        _recentDigests.push_back(digest);
+        return;
+    }
+    _recentDigests[_nextDigest] = digest;
+    _nextDigest = (_nextDigest + 1) % _recentDigests.size();
+}
+
+std::optional<uint64_t>
+    DumpDigest::computeDigest(const std::filesystem::path& path)
+{
+#ifdef DUMP_DEDUP
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+    std::unique_ptr<XXH3_state_t, decltype(&XXH3_freeState)> state(
+        XXH3_createState(), &XXH3_freeState);
+    if (!state || XXH3_64bits_reset(state.get()) != XXH_OK)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    // map a window at a time, dumps could be larger than the address space
+    uint64_t size = st.st_size;
+    uint64_t offset = 0;
+    while (offset < size)
+    {
+        size_t len = std::min<uint64_t>(digestWindowSize, size - offset);
+        void* addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, offset);
+        if (addr == MAP_FAILED)
+        {
+            close(fd);
+            return std::nullopt;
+        }
+        madvise(addr, len, MADV_SEQUENTIAL);
+        XXH3_64bits_update(state.get(), addr, len);
+        munmap(addr, len);
+        offset += len;
+    }
+    close(fd);
+    return XXH3_64bits_digest(state.get());
+#else
+    (void)path;
+    return std::nullopt;
+#endif
+}
+} // namespace openpower::dump
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "dump_key.hpp"
+#include "worker_pool.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace openpower::dump
+{
+
+/**
+ * @class DumpDigest
+ * @brief Content digest of the dump files
+ * @details Dump file is hashed with XXH3 on the worker thread, digests of
+ *  the recently offloaded dumps are remembered so that a dump identical to
+ *  a recently offloaded dump can be identified before it is offloaded.
+ */
+class DumpDigest
+{
+  public:
+    DumpDigest() = delete;
+    DumpDigest(const DumpDigest&) = delete;
+    DumpDigest& operator=(const DumpDigest&) = delete;
+    DumpDigest(DumpDigest&&) = delete;
+    DumpDigest& operator=(DumpDigest&&) = delete;
+    virtual ~DumpDigest() = default;
+
+    /** @brief Callback invoked on the event loop with the dump digest,
+     *  nullopt if the dump file could not be read */
+    using Callback = std::function<void(const DumpKey& key,
+                                        std::optional<uint64_t> digest)>;
+
+    /**
+     * @brief Constructor
+     * @param[in] workerPool - worker pool to hash the dump files on
+     * @param[in] callback - invoked when the hashing of a dump is done
+     */
+    DumpDigest(WorkerPool& workerPool, Callback callback);
+
+    /**
+     * @brief Check if the dumps are hashed
+     * @return true if built with the XXH3 support
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Compute the digest of the dump file on the worker thread
+     * @param[in] key - key of the dump
+     */
+    void hash(const DumpKey& key);
+
+    /**
+     * @brief Get the number of dumps being hashed
+     * @return number of hashing jobs posted and not yet completed
+     */
+    size_t getPendingCount() const
+    {
+        return _pendingCount;
+    }
+
+    /**
+     * @brief Check if a dump with the digest was recently offloaded
+     * @param[in] digest - digest of the dump
+     * @return true if the digest is of a recently offloaded dump
+     */
+    bool isRecentlyOffloaded(uint64_t digest) const;
+
+    /**
+     * @brief Remember the digest of the dump being offloaded
+     * @param[in] digest - digest of the dump
+     */
+    void offloaded(uint64_t digest);
+
+  private:
+    /**
+     * @brief Hash the file in bounded mmap windows, runs on the worker
+     *        thread
+     * @param[in] path - dump file
+     * @return digest of the file, nullopt on error
+     */
+    static std::optional<uint64_t>
+        computeDigest(const std::filesystem::path& path);
+
+    /** @brief worker pool to hash on */
+    WorkerPool& _workerPool;
+
+    /** @brief callback to notify the digest */
+    Callback _callback;
+
+    /** @brief digests of the recently offloaded dumps, used as a ring */
+    std::vector<uint64_t> _recentDigests;
+
+    /** @brief next slot to overwrite once the ring is full */
+    size_t _nextDigest = 0;
+
+    /** @brief hashing jobs posted and not yet completed */
+    size_t _pendingCount = 0;
+};
+} // namespace openpower::dump
@@ -0,0 +1,92 @@
+#include "config.h"
+
+#include "dump_key.hpp"
+
+#include "logging.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <charconv>
+#include <stdexcept>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+const std::string& getEntryObjPath(DumpType type)
+{
+    // indexed by the dump type
+    static const std::array<std::string, 4> entryObjPaths = {
+        bmcEntryObjPath, hardwareEntryObjPath, hostbootEntryObjPath,
+        sbeEntryObjPath};
+
+    auto index = static_cast<size_t>(type);
+    if (index >= entryObjPaths.size())
+    {
+        logMsg<level::ERR>("Unsupported dump type ({})", type);
+        throw std::out_of_range(
+            fmt::format("Unsupported dump type ({}) ", type));
+    }
+    return entryObjPaths[index];
+}
+
+const std::string& getDumpFileDir(DumpType type)
+{
+    // indexed by the dump type
+    static const std::array<std::string, 4> dumpFileDirs = {
+        bmcDumpFilePath, hardwareDumpFilePath, hostbootDumpFilePath,
+        sbeDumpFilePath};
+
+    auto index = static_cast<size_t>(type);
+    if (index >= dumpFileDirs.size())
+    {
+        logMsg<level::ERR>("Unsupported dump type ({})", type);
+        throw std::out_of_range(
+            fmt::format("Unsupported dump type ({}) ", type));
+    }
+    return dumpFileDirs[index];
+}
+
+std::optional<std::filesystem::path> getDumpFilePath(const DumpKey& key)
+{
+    std::error_code ec;
+    std::filesystem::path dir =
+        std::filesystem::path(getDumpFileDir(key.type)) /
+        std::to_string(key.id);
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        if (entry.is_regular_file(ec))
+        {
+            return entry.path();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<DumpKey> getDumpKey(DumpType type, const object_path& path)
+{
+    const std::string& str = path.str;
+    auto pos = str.rfind('/');
+    if (pos == std::string::npos)
+    {
+        return std::nullopt;
+    }
+    uint32_t id = 0;
+    const char* begin = str.data() + pos + 1;
+    const char* end = str.data() + str.size();
+    auto [ptr, ec] = std::from_chars(begin, end, id);
+    if (ec != std::errc() || ptr != end || begin == end)
+    {
+        logMsg<level::ERR>("Dump key invalid dump id in path ({})", str);
+        return std::nullopt;
+    }
+    return DumpKey{type, id};
+}
+
+object_path getDumpObjPath(const DumpKey& key)
+{
+    return object_path(getEntryObjPath(key.type) + std::to_string(key.id));
+}
+} // namespace openpower::dump
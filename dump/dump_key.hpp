@@ -0,0 +1,75 @@
+#pragma once
+
+#include "utility.hpp"
+
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <sdbusplus/message.hpp>
+#include <string>
+#include <vector>
+
+namespace openpower::dump
+{
+using ::openpower::dump::utility::DumpType;
+using ::sdbusplus::message::object_path;
+
+/**
+ * @struct DumpKey
+ * @brief Compact key to identify a dump entry
+ * @details Dump entry object paths are made of the entry path of the dump
+ *          type and the numeric dump id, the path is rebuilt from the key
+ *          when needed instead of keeping a copy of it for every dump.
+ */
+struct DumpKey
+{
+    /** @brief type of the dump */
+    DumpType type;
+
+    /** @brief id of the dump entry */
+    uint32_t id;
+
+    auto operator<=>(const DumpKey&) const = default;
+};
+static_assert(sizeof(DumpKey) == 8, "DumpKey is expected to be 8 bytes");
+
+/** @brief list of dump keys */
+using DumpList = std::vector<DumpKey>;
+
+/**
+ * @brief Get the entry object path prefix of the dump type
+ * @param[in] type - type of the dump
+ * @return entry object path prefix, interned for the life of the process
+ */
+const std::string& getEntryObjPath(DumpType type);
+
+/**
+ * @brief Get the directory in which dumps of the type are stored
+ * @param[in] type - type of the dump
+ * @return dump file directory, each dump is in a sub directory named by id
+ */
+const std::string& getDumpFileDir(DumpType type);
+
+/**
+ * @brief Get the path of the dump file
+ * @param[in] key - key of the dump
+ * @return path of the dump file, nullopt if the dump file is not found
+ */
+std::optional<std::filesystem::path> getDumpFilePath(const DumpKey& key);
+
+/**
+ * @brief Get the key of the dump entry object
+ * @param[in] type - type of the dump
+ * @param[in] path - D-Bus path of the dump entry object
+ * @return key of the dump, nullopt if the path has no numeric dump id
+ */
+std::optional<DumpKey> getDumpKey(DumpType type, const object_path& path);
+
+/**
+ * @brief Get the D-Bus path of the dump entry object
+ * @param[in] key - key of the dump
+ * @return D-Bus path of the dump entry object
+ */
+object_path getDumpObjPath(const DumpKey& key);
+} // namespace openpower::dump
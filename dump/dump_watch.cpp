@@ -2,178 +2,142 @@
 
 #include "dump_watch.hpp"
 
-#include "dbus_util.hpp"
+#include "logging.hpp"
 
-#include <fmt/format.h>
-
-#include <phosphor-logging/log.hpp>
+#include <algorithm>
 
 namespace openpower::dump
 {
-using ::openpower::dump::utility::DBusInteracesList;
-using ::openpower::dump::utility::DBusInteracesMap;
-using ::openpower::dump::utility::DBusPropertiesMap;
+using ::openpower::dump::logging::logMsg;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
-using ::sdbusplus::bus::match::rules::sender;
 
-DumpWatch::DumpWatch(sdbusplus::bus::bus& bus, HostOffloaderQueue& dumpQueue,
-                     const std::string& entryObjPath, DumpType dumpType) :
-    _bus(bus),
-    _dumpQueue(dumpQueue), _dumpType(dumpType)
+/** @brief Number of removals drained in one pass to be logged as a storm */
+constexpr auto removalStormThreshold = 16;
+
+DumpWatch::DumpWatch(sdeventplus::Event& event,
+                     HostOffloaderQueue& dumpQueue, DumpType dumpType) :
+    _dumpQueue(dumpQueue),
+    _dumpType(dumpType),
+    _drainEvent(event,
+                std::bind(std::mem_fn(&DumpWatch::drainRemovedDumps), this))
 {
-    _intfAddWatch = std::make_unique<sdbusplus::bus::match_t>(
-        bus,
-        sdbusplus::bus::match::rules::interfacesAdded() +
-            sdbusplus::bus::match::rules::argNpath(0, entryObjPath),
-        [this](auto& msg) { this->interfaceAdded(msg); });
-
-    _intfRemWatch = std::make_unique<sdbusplus::bus::match_t>(
-        bus,
-        sdbusplus::bus::match::rules::interfacesRemoved() +
-            sdbusplus::bus::match::rules::argNpath(0, entryObjPath),
-        [this](auto& msg) { this->interfaceRemoved(msg); });
+    _drainEvent.set_priority(SD_EVENT_PRIORITY_IDLE);
+    _drainEvent.set_enabled(sdeventplus::source::Enabled::Off);
 }
 
-void DumpWatch::interfaceAdded(sdbusplus::message::message& msg)
+std::vector<uint32_t>::iterator DumpWatch::findInProgressDump(uint32_t id)
 {
-    try
-    {
-        sdbusplus::message::object_path objPath;
-        DBusInteracesMap interfaces;
-        msg.read(objPath, interfaces);
-        log<level::INFO>(
-            fmt::format("Watch interfaceAdded path ({})", objPath.str).c_str());
-
-        // check if dump generation is already completed
-        bool isComplete = false;
-        auto iface = interfaces.find(progressIntf);
-        if (iface != interfaces.end())
-        {
-            auto prop = iface->second.find("Status");
-            if (prop != iface->second.end())
-            {
-                auto status = std::get_if<std::string>(&prop->second);
-                if (status != nullptr)
-                {
-                    if (*status == progressComplete)
-                    {
-                        isComplete = true;
-                    }
-                }
-            }
-        }
-        if (isComplete)
-        {
-            // queue the dump for offloading
-            _dumpQueue.enqueue(objPath, _dumpType);
-        }
-        else
-        {
-            _entryPropWatchList.emplace(
-                objPath, std::make_unique<sdbusplus::bus::match_t>(
-                             _bus,
-                             sdbusplus::bus::match::rules::propertiesChanged(
-                                 objPath, progressIntf),
-                             [this, objPath](auto& msg) {
-                                 this->propertiesChanged(objPath, msg);
-                             }));
-        }
-    }
-    catch (const std::exception& ex)
+    auto iter = std::lower_bound(_inProgressDumps.begin(),
+                                 _inProgressDumps.end(), id);
+    if (iter != _inProgressDumps.end() && *iter == id)
     {
-        log<level::ERR>(
-            fmt::format("Watch exception in interfaceAdded ({})", ex.what())
-                .c_str());
-        throw;
+        return iter;
     }
+    return _inProgressDumps.end();
 }
 
-void DumpWatch::interfaceRemoved(sdbusplus::message::message& msg)
+void DumpWatch::dumpAdded(uint32_t id, bool isComplete, uint64_t size)
 {
-    try
+    if (isComplete)
     {
-        sdbusplus::message::object_path objPath;
-        DBusInteracesList interfaces;
-        msg.read(objPath, interfaces);
-        log<level::INFO>(
-            fmt::format("Watch interfaceRemoved path ({})", objPath.str)
-                .c_str());
-
-        _dumpQueue.dequeue(objPath);
-        _entryPropWatchList.erase(objPath);
+        // queue the dump for offloading
+        _dumpQueue.enqueue(DumpKey{_dumpType, id}, size);
+        return;
     }
-    catch (const std::exception& ex)
+    auto iter = std::lower_bound(_inProgressDumps.begin(),
+                                 _inProgressDumps.end(), id);
+    if (iter == _inProgressDumps.end() || *iter != id)
     {
-        log<level::ERR>(
-            fmt::format("Watch exception in interfaceRemoved ({})", ex.what())
-                .c_str());
-        throw;
+        _inProgressDumps.insert(iter, id);
     }
 }
 
-void DumpWatch::propertiesChanged(const object_path& objPath,
-                                  sdbusplus::message::message& msg)
+void DumpWatch::dumpRemoved(uint32_t id)
 {
-    try
+    // removals are drained once the pending signals are processed,
+    // until then do not announce dumps which might already be deleted
+    if (_removedDumps.empty())
     {
-        std::string interface;
-        DBusPropertiesMap propMap;
-        msg.read(interface, propMap);
-        log<level::INFO>(
-            fmt::format("Watch propertiesChanged object path ({})", objPath.str)
-                .c_str());
-
-        bool fcomplete = isDumpProgressCompleted(propMap);
-        if (!fcomplete)
-        {
-            log<level::DEBUG>(
-                fmt::format("Watch propertiesChanged object path ({}) "
-                            "status is not completed",
-                            objPath.str)
-                    .c_str());
-            return;
-        }
-
-        // queue the dump for offloading
-        _dumpQueue.enqueue(objPath, _dumpType);
+        _dumpQueue.suspend();
+        _drainEvent.set_enabled(sdeventplus::source::Enabled::OneShot);
+    }
+    _removedDumps.emplace_back(DumpKey{_dumpType, id});
+}
 
-        _entryPropWatchList.erase(objPath);
+void DumpWatch::drainRemovedDumps()
+{
+    if (_removedDumps.size() >= removalStormThreshold)
+    {
+        logMsg<level::INFO>("Watch removal storm ({}) dumps removed type ({})",
+                            _removedDumps.size(), _dumpType);
     }
-    catch (const std::exception& ex)
+    std::erase_if(_inProgressDumps, [this](uint32_t id) {
+        return std::find(_removedDumps.begin(), _removedDumps.end(),
+                         DumpKey{_dumpType, id}) != _removedDumps.end();
+    });
+    _dumpQueue.dequeue(_removedDumps);
+    _removedDumps.clear();
+    _dumpQueue.resume();
+}
+
+void DumpWatch::dumpCompleted(uint32_t id)
+{
+    auto iter = findInProgressDump(id);
+    if (iter == _inProgressDumps.end())
     {
-        log<level::ERR>(
-            fmt::format("Watch exception in propertiesChanged ({})", ex.what())
-                .c_str());
-        throw;
+        return;
     }
+    _inProgressDumps.erase(iter);
+
+    // queue the dump for offloading
+    _dumpQueue.enqueue(DumpKey{_dumpType, id});
+}
+
+void DumpWatch::dumpOffloaded(uint32_t id)
+{
+    // offload is complete, release the queue for the next dump
+    _dumpQueue.dequeue(DumpKey{_dumpType, id});
 }
 
-void DumpWatch::addInProgressDumpsToWatch(std::vector<std::string> paths)
+void DumpWatch::dispatch(const trace::Record& rec)
 {
-    try
+    switch (rec.signal)
     {
-        for (auto& path : paths)
-        {
-            object_path objPath = path;
-            _entryPropWatchList.emplace(
-                objPath, std::make_unique<sdbusplus::bus::match_t>(
-                             _bus,
-                             sdbusplus::bus::match::rules::propertiesChanged(
-                                 objPath, progressIntf),
-                             [this, objPath](auto& msg) {
-                                 this->propertiesChanged(objPath, msg);
-                             }));
-        }
+        case trace::Signal::dumpAdded:
+            dumpAdded(rec.id, rec.flag, rec.value);
+            break;
+        case trace::Signal::dumpRemoved:
+            dumpRemoved(rec.id);
+            break;
+        case trace::Signal::dumpCompleted:
+            dumpCompleted(rec.id);
+            break;
+        case trace::Signal::dumpOffloaded:
+            dumpOffloaded(rec.id);
+            break;
+        default:
+            break;
     }
-    catch (const std::exception& ex)
+}
+
+void DumpWatch::release()
+{
+    if (!_removedDumps.empty())
     {
-        log<level::ERR>(
-            fmt::format("Watch exception in addInProgressDumpsToWatch ({})",
-                        ex.what())
-                .c_str());
-        throw;
+        _drainEvent.set_enabled(sdeventplus::source::Enabled::Off);
+        _dumpQueue.resume();
     }
+    DumpList().swap(_removedDumps);
+    std::vector<uint32_t>().swap(_inProgressDumps);
+}
+
+void DumpWatch::addInProgressDumpsToWatch(const std::vector<uint32_t>& ids)
+{
+    _inProgressDumps.insert(_inProgressDumps.end(), ids.begin(), ids.end());
+    std::sort(_inProgressDumps.begin(), _inProgressDumps.end());
+    _inProgressDumps.erase(
+        std::unique(_inProgressDumps.begin(), _inProgressDumps.end()),
+        _inProgressDumps.end());
 }
 
 } // namespace openpower::dump
@@ -1,12 +1,13 @@
 #pragma once
 
+#include "dump_key.hpp"
 #include "host_offloader_queue.hpp"
+#include "signal_trace.hpp"
 #include "utility.hpp"
 
-#include <map>
-#include <memory>
-#include <sdbusplus/bus.hpp>
-#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <vector>
 
 namespace openpower::dump
 {
@@ -16,9 +17,10 @@ using ::sdbusplus::message::object_path;
 
 /**
  * @class DumpWatch
- * @brief Add watch on new dump entries created/deleted so as to offload
- * @details Adds watch on the dump progress property for the newly created
- *  dumps. Initiates offload when dump progress property is changed to complete
+ * @brief Track the dump entries created/deleted so as to offload
+ * @details Handles the dump signals decoded by the signal thread. Tracks the
+ *  ids of the dumps in progress and initiates offload when the dump
+ *  progress is changed to complete.
  */
 class DumpWatch
 {
@@ -31,48 +33,81 @@ class DumpWatch
     virtual ~DumpWatch() = default;
 
     /**
-     * @brief Watch on new dump objects created and property change
-     * @param[in] bus - Bus to attach to
+     * @brief Constructor
+     * @param[in] event - event handler
      * @param[in] dumpQueue - To queue and offload dump
-     * @param[in] entryObjPath - dump entry object path
      * @param[in] dumpType - dump type to watch
      */
-    DumpWatch(sdbusplus::bus::bus& bus, HostOffloaderQueue& dumpQueue,
-              const std::string& entryObjPath, DumpType dumpType);
+    DumpWatch(sdeventplus::Event& event, HostOffloaderQueue& dumpQueue,
+              DumpType dumpType);
 
     /**
      * @brief Add all in progress dumps to property watch
-     * @param[in] objects dump object paths
+     * @param[in] ids ids of the dumps in progress
      * @return void
      */
-    void addInProgressDumpsToWatch(std::vector<std::string> paths);
+    void addInProgressDumpsToWatch(const std::vector<uint32_t>& ids);
 
-  private:
     /**
-     * @brief Callback method for creation of dump entry object
-     * @param[in] msg response msg from D-Bus request
-     * @return void
+     * @brief Dump entry is created
+     * @param[in] id - id of the dump
+     * @param[in] isComplete - dump generation is completed
+     * @param[in] size - size of the dump if known else 0
      */
-    void interfaceAdded(sdbusplus::message::message& msg);
+    void dumpAdded(uint32_t id, bool isComplete, uint64_t size);
 
     /**
-     * @brief Callback method for deletion of dump entry object
-     * @param[in] msg response msg from D-Bus request
-     * @return void
+     * @brief Dump entry is deleted
+     * @param[in] id - id of the dump
      */
-    void interfaceRemoved(sdbusplus::message::message& msg);
+    void dumpRemoved(uint32_t id);
 
     /**
-     * @brief Callback method for property change on the entry object
-     * @param[in] objPath Object path of the dump entry
-     * @param[in] msg response msg from D-Bus request
-     * @return void
+     * @brief Dump generation is completed
+     * @param[in] id - id of the dump
      */
-    void propertiesChanged(const object_path& objPath,
-                           sdbusplus::message::message& msg);
+    void dumpCompleted(uint32_t id);
 
-    /** @brief D-Bus to connect to */
-    sdbusplus::bus::bus& _bus;
+    /**
+     * @brief Dump is marked offloaded
+     * @param[in] id - id of the dump
+     */
+    void dumpOffloaded(uint32_t id);
+
+    /**
+     * @brief Handle a decoded dump signal
+     * @param[in] rec - record of the signal
+     */
+    void dispatch(const trace::Record& rec);
+
+    /**
+     * @brief Forget the watched dumps when the system becomes HMC managed,
+     *        the dumps are enumerated again on the transition back
+     */
+    void release();
+
+    /**
+     * @brief Check if no dump is in progress or pending removal
+     * @return true if idle else false
+     */
+    bool isIdle() const
+    {
+        return _inProgressDumps.empty() && _removedDumps.empty();
+    }
+
+  private:
+    /**
+     * @brief Remove all the dumps deleted since the last drain from the
+     *        queue and the watch list in one pass and resume offload
+     */
+    void drainRemovedDumps();
+
+    /**
+     * @brief Check if the dump is in the in progress dumps
+     * @param[in] id - id of the dump
+     * @return iterator to the id if found else end of in progress dumps
+     */
+    std::vector<uint32_t>::iterator findInProgressDump(uint32_t id);
 
     /** @brief Queue to offload dump requests */
     HostOffloaderQueue& _dumpQueue;
@@ -80,14 +115,17 @@ class DumpWatch
     /** @brief type of the dump to watch for */
     DumpType _dumpType;
 
-    /** @brief watch pointer for interfaces added */
-    std::unique_ptr<sdbusplus::bus::match_t> _intfAddWatch;
+    /**
+     * @brief dumps deleted and yet to be removed from the queue, on a delete
+     *  all request this collects the whole burst of interfaces removed
+     *  signals while offload is suspended.
+     */
+    DumpList _removedDumps;
 
-    /** @brief watch pointer for interfaces removed */
-    std::unique_ptr<sdbusplus::bus::match_t> _intfRemWatch;
+    /** @brief idle priority event to drain the removed dumps */
+    sdeventplus::source::Defer _drainEvent;
 
-    /** @brief map of property change request for the corresponding entry */
-    std::map<object_path, std::unique_ptr<sdbusplus::bus::match_t>>
-        _entryPropWatchList;
+    /** @brief sorted ids of the dumps for which generation is in progress */
+    std::vector<uint32_t> _inProgressDumps;
 };
 } // namespace openpower::dump
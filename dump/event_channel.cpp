@@ -0,0 +1,93 @@
+#include "event_channel.hpp"
+
+#include "logging.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+EventChannel::EventChannel(sdeventplus::Event& event)
+{
+    _eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_eventFd < 0)
+    {
+        auto error = errno;
+        logMsg<level::ERR>("Channel failed to create eventfd errno ({})",
+                           error);
+        throw std::runtime_error(strerror(error));
+    }
+    _eventSource = std::make_unique<sdeventplus::source::IO>(
+        event, _eventFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int fd, uint32_t) {
+            uint64_t count = 0;
+            if (read(fd, &count, sizeof(count)) == sizeof(count))
+            {
+                this->runCallbacks();
+            }
+        });
+}
+
+EventChannel::~EventChannel()
+{
+    _eventSource.reset();
+    close(_eventFd);
+
+    // callbacks not yet run are dropped
+    auto node = _head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        std::unique_ptr<Node> done(node);
+        node = node->next;
+    }
+}
+
+void EventChannel::post(Callback callback)
+{
+    auto node = new Node{std::move(callback)};
+    node->next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+    {
+    }
+    if (node->next != nullptr)
+    {
+        // event loop is already signalled and yet to take the queue
+        return;
+    }
+    uint64_t count = 1;
+    if (write(_eventFd, &count, sizeof(count)) != sizeof(count))
+    {
+        logMsg<level::ERR>("Channel failed to signal errno ({})", errno);
+    }
+}
+
+void EventChannel::runCallbacks()
+{
+    // take the whole queue and reverse it to run in the posted order
+    auto node = _head.exchange(nullptr, std::memory_order_acquire);
+    Node* ordered = nullptr;
+    while (node != nullptr)
+    {
+        auto next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+    while (ordered != nullptr)
+    {
+        std::unique_ptr<Node> done(ordered);
+        ordered = ordered->next;
+        done->callback();
+    }
+}
+} // namespace openpower::dump
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+namespace openpower::dump
+{
+
+/**
+ * @class EventChannel
+ * @brief Pass callbacks from any thread to run on the event loop thread
+ * @details Callbacks are pushed to a lock-free multi producer single
+ *  consumer queue, the event loop is signalled through an eventfd only when
+ *  the queue turns non empty and runs the callbacks in the order posted.
+ */
+class EventChannel
+{
+  public:
+    EventChannel() = delete;
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+    EventChannel(EventChannel&&) = delete;
+    EventChannel& operator=(EventChannel&&) = delete;
+    virtual ~EventChannel();
+
+    /** @brief Callback run on the event loop */
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param[in] event - event loop to run the callbacks on
+     */
+    explicit EventChannel(sdeventplus::Event& event);
+
+    /**
+     * @brief Post the callback to the event loop, called from any thread
+     * @param[in] callback - callback to run on the event loop
+     */
+    void post(Callback callback);
+
+  private:
+    /** @brief callback queued */
+    struct Node
+    {
+        Callback callback;
+        Node* next = nullptr;
+    };
+
+    /** @brief run the callbacks posted */
+    void runCallbacks();
+
+    /** @brief callbacks posted, most recent first */
+    std::atomic<Node*> _head = nullptr;
+
+    /** @brief eventfd signalled when the queue turns non empty */
+    int _eventFd = -1;
+
+    /** @brief event source of the eventfd */
+    std::unique_ptr<sdeventplus::source::IO> _eventSource;
+};
+} // namespace openpower::dump
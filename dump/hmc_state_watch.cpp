@@ -2,20 +2,17 @@
 
 #include "dbus_util.hpp"
 
-#include <fmt/format.h>
-
-#include <phosphor-logging/log.hpp>
+#include "logging.hpp"
+#include "signal_trace.hpp"
 
 namespace openpower::dump
 {
 using ::openpower::dump::utility::DBusPropertiesMap;
+using ::openpower::dump::logging::logMsg;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
 
-HMCStateWatch::HMCStateWatch(sdbusplus::bus::bus& bus,
-                             HostOffloaderQueue& dumpQueue) :
-    _bus(bus),
-    _dumpQueue(dumpQueue)
+HMCStateWatch::HMCStateWatch(sdbusplus::bus::bus& bus, Callback callback) :
+    _bus(bus), _callback(std::move(callback))
 {
     _hmcStatePropWatch = std::make_unique<sdbusplus::bus::match_t>(
         _bus,
@@ -51,16 +48,10 @@ void HMCStateWatch::propertyChanged(sdbusplus::message::message& msg)
                 {
                     auto attrValue = std::get<5>(std::get<1>(item));
                     auto val = std::get_if<std::string>(&attrValue);
-                    if (val != nullptr && *val == "Enabled")
-                    {
-                        log<level::INFO>("System changed to HMC managed");
-                        _dumpQueue.hmcStateChange(true);
-                    }
-                    else
-                    {
-                        log<level::INFO>("System changed to non HMC managed");
-                        _dumpQueue.hmcStateChange(false);
-                    }
+                    bool isHMCManaged = (val != nullptr && *val == "Enabled");
+                    trace::record(trace::Signal::hmcState, DumpType::bmc, 0,
+                                  isHMCManaged);
+                    hmcStateChanged(isHMCManaged);
                     break;
                 }
             }
@@ -68,4 +59,17 @@ void HMCStateWatch::propertyChanged(sdbusplus::message::message& msg)
     }
 }
 
+void HMCStateWatch::hmcStateChanged(bool isHMCManaged)
+{
+    if (isHMCManaged)
+    {
+        logMsg<level::INFO>("System changed to HMC managed");
+    }
+    else
+    {
+        logMsg<level::INFO>("System changed to non HMC managed");
+    }
+    _callback(isHMCManaged);
+}
+
 } // namespace openpower::dump
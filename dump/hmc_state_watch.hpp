@@ -1,6 +1,7 @@
 #pragma once
-#include "host_offloader_queue.hpp"
 
+#include <functional>
+#include <memory>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
 
@@ -22,12 +23,21 @@ class HMCStateWatch
     HMCStateWatch& operator=(HMCStateWatch&&) = delete;
     virtual ~HMCStateWatch() = default;
 
+    /** @brief Callback invoked with the new HMC state */
+    using Callback = std::function<void(bool isHMCManaged)>;
+
     /**
      * @brief Watch on new HMC state change
      * @param[in] bus - Bus to attach to
-     * @param[in] dumpQueue - dump queue
+     * @param[in] callback - invoked when the HMC state changes
+     */
+    HMCStateWatch(sdbusplus::bus::bus& bus, Callback callback);
+
+    /**
+     * @brief HMC state is changed
+     * @param[in] isHMCManaged - True if system is HMC managed
      */
-    HMCStateWatch(sdbusplus::bus::bus& bus, HostOffloaderQueue& dumpQueue);
+    void hmcStateChanged(bool isHMCManaged);
 
   private:
     /**
@@ -40,8 +50,8 @@ class HMCStateWatch
     /** @brief D-Bus to connect to */
     sdbusplus::bus::bus& _bus;
 
-    /** @brief Queue to offload dump requests */
-    HostOffloaderQueue& _dumpQueue;
+    /** @brief invoked when the HMC state changes */
+    Callback _callback;
 
     /*@brief watch for hmc state change */
     std::unique_ptr<sdbusplus::bus::match_t> _hmcStatePropWatch;
@@ -1,43 +1,85 @@
+#include "config.h"
+
 #include "dbus_util.hpp"
+#include "logging.hpp"
 #include "offload_manager.hpp"
-
-#include <fmt/format.h>
+#include "pldm_transport.hpp"
+#include "signal_trace.hpp"
 
 #include <cstdlib>
-#include <phosphor-logging/log.hpp>
+#include <memory>
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/source/event.hpp>
+#include <string>
 
+using ::openpower::dump::logging::logMsg;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
 
 int main()
 {
     try
     {
+        openpower::dump::logging::initLogLevel();
+        openpower::dump::trace::initRecorder();
         auto bus = sdbusplus::bus::new_default();
+        // host and HMC state changes stop the offload, they are received on
+        // a connection of their own so that they are not queued behind a
+        // flood of dump signals
+        auto controlBus = sdbusplus::bus::new_system();
         auto event = sdeventplus::Event::get_default();
-        // Changing a system from hmc-managed to non-hmc manged is a disruptive
-        // process (Power off the system, do some clean ups and IPL).
-        // Changing a system from non-hmc managed to hmc-manged can be done at
-        // runtime.
-        // Not creating offloader objects if system is HMC managed
-        // TODO #https://github.com/ibm-openbmc/powervm-handler/issues/8
-        if (openpower::dump::isSystemHMCManaged(bus))
+
+        // replay a recorded signal trace instead of the startup offload, the
+        // dumps are not announced to the host, and the service name and the
+        // offload history are left to the running daemon
+        const char* replayPath = std::getenv("PVM_DUMP_OFFLOAD_REPLAY");
+        std::unique_ptr<openpower::dump::Transport> transport;
+        uint32_t historySize = offloadHistorySize;
+        if (replayPath != nullptr)
+        {
+            transport = std::make_unique<openpower::dump::NullTransport>();
+            historySize = 0;
+        }
+        else
+        {
+            transport =
+                std::make_unique<openpower::dump::pldm::PldmTransport>();
+        }
+        openpower::dump::OffloadManager manager(bus, controlBus, event,
+                                                *transport, offloadHistoryFile,
+                                                historySize);
+
+        std::unique_ptr<openpower::dump::trace::Replayer> replayer;
+        if (replayPath != nullptr)
+        {
+            const char* speed = std::getenv("PVM_DUMP_OFFLOAD_REPLAY_SPEED");
+            bool maxSpeed = (speed != nullptr && std::string(speed) == "max");
+            replayer = std::make_unique<openpower::dump::trace::Replayer>(
+                event, replayPath, maxSpeed,
+                [&manager](const auto& rec) { manager.dispatch(rec); },
+                [&event]() { event.exit(EXIT_SUCCESS); });
+            replayer->start();
+        }
+        else
         {
-            log<level::ERR>("HMC managed system exiting the application");
-            return 0;
+            bus.request_name(offloadService);
+            manager.offload();
         }
-        openpower::dump::OffloadManager manager(bus, event);
-        manager.offload();
         bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+        // on replay the host and HMC state come from the trace, the live
+        // state watches on the control connection are not dispatched
+        if (replayPath == nullptr)
+        {
+            controlBus.attach_event(event.get(), SD_EVENT_PRIORITY_IMPORTANT);
+        }
+        // keepalives are sent from the event loop when WatchdogSec is set,
+        // a wedged loop stops them and the service is restarted
+        event.set_watchdog(true);
         return event.loop();
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("exception during application load({})", ex.what())
-                .c_str());
+        logMsg<level::ERR>("exception during application load({})",
+                           ex.what());
         throw;
     }
 }
@@ -3,34 +3,57 @@
 #include "host_offloader_queue.hpp"
 
 #include "dbus_util.hpp"
-#include "send_pldm_cmd.hpp"
 
-#include <fmt/format.h>
+#include "logging.hpp"
 
-#include <phosphor-logging/log.hpp>
+#include <algorithm>
 
 namespace openpower::dump
 {
 using ::openpower::dump::utility::DBusInteracesList;
+using ::openpower::dump::logging::logDump;
+using ::openpower::dump::logging::logMsg;
+using ::openpower::dump::logging::logRateLimited;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
-using ::sdbusplus::bus::match::rules::sender;
 
 constexpr auto timeoutInMilliSeconds = 5000; // 5 sec
+constexpr auto errorLogInterval = std::chrono::seconds(60);
+constexpr auto errorLogBurst = 10;
+constexpr auto transportMinBackoff = std::chrono::seconds(5);
+constexpr auto transportMaxBackoff = std::chrono::minutes(5);
 
 HostOffloaderQueue::HostOffloaderQueue(sdbusplus::bus::bus& bus,
-                                       sdeventplus::Event& event) :
+                                       sdeventplus::Event& event,
+                                       Transport& transport,
+                                       StatusCallback statusCallback,
+                                       const std::string& historyFile,
+                                       uint32_t historySize) :
     _bus(bus),
-    _event(event), _offloadTimeout(timeoutInMilliSeconds),
+    _event(event), _transport(transport),
+    _statusCallback(std::move(statusCallback)),
+    _throughput(prefetchReadRate), _offloadTimeout(timeoutInMilliSeconds),
     _offloadTimer(
         event, std::bind(std::mem_fn(&HostOffloaderQueue::timerExpired), this),
-        _offloadTimeout)
+        _offloadTimeout),
+    _scheduleEvent(
+        event,
+        std::bind(std::mem_fn(&HostOffloaderQueue::schedulePass), this)),
+    _errorLogLimit(errorLogInterval, errorLogBurst),
+    _transportCircuit(transportMinBackoff, transportMaxBackoff),
+    _workerPool(event, workerThreadCount),
+    _dumpDigest(_workerPool,
+                [this](const DumpKey& key, std::optional<uint64_t> digest) {
+                    digestCompleted(key, digest);
+                }),
+    _prefetchStage(_workerPool),
+    _history(historyFile, historySize)
 {
-    // initally read the value as this app might run after host is started
-    isHostRunning = openpower::dump::isHostRunning(_bus);
-    isHMCManagedSystem = openpower::dump::isSystemHMCManaged(_bus);
+    _scheduleEvent.set_priority(SD_EVENT_PRIORITY_IDLE);
+    _scheduleEvent.set_enabled(sdeventplus::source::Enabled::Off);
 
-    // intially stop the timer, start only when dumps are added to the queue
+    // host and HMC states are updated by the offload manager once the
+    // startup reads are completed, intially stop the timer, start only when
+    // dumps are added to the queue
     stopTimer();
 }
 
@@ -39,76 +62,169 @@ void HostOffloaderQueue::startTimer()
     if (!_offloadTimer.isEnabled() && isHostRunning && !isHMCManagedSystem &&
         !_offloadDumpList.empty())
     {
-        log<level::INFO>(
-            fmt::format("Queue start timer host running ({}) hmcmanaged ({})"
-                        "Dumps size  ({})",
-                        isHostRunning, isHMCManagedSystem,
-                        _offloadDumpList.size())
-                .c_str());
+        logMsg<level::INFO>("Queue start timer host running ({}) hmcmanaged "
+                            "({}) Dumps size ({})",
+                            isHostRunning, isHMCManagedSystem,
+                            _offloadDumpList.size());
         _offloadTimer.setEnabled(true);
     }
     else if (_offloadTimer.isEnabled() && !isHostRunning)
     {
-        log<level::INFO>("Queue stop timer host is not in running state");
+        logMsg<level::INFO>("Queue stop timer host is not in running state");
         stopTimer();
     }
     else if (_offloadTimer.isEnabled() && isHMCManagedSystem)
     {
-        log<level::INFO>("Queue stop timer system is HMC managed");
+        logMsg<level::INFO>("Queue stop timer system is HMC managed");
         stopTimer();
     }
 }
 
 void HostOffloaderQueue::stopTimer()
 {
-    log<level::INFO>(
-        fmt::format("Queue stop timer host running ({}) hmcmanaged ({})"
-                    "Dumps size  ({})",
-                    isHostRunning, isHMCManagedSystem, _offloadDumpList.size())
-            .c_str());
+    logMsg<level::INFO>("Queue stop timer host running ({}) hmcmanaged ({}) "
+                        "Dumps size ({})",
+                        isHostRunning, isHMCManagedSystem,
+                        _offloadDumpList.size());
     _offloadTimer.setEnabled(false);
 }
 
 void HostOffloaderQueue::timerExpired()
 {
+    if (_offloadInProgress)
+    {
+        _prefetchStage.advance();
+    }
     offload();
 }
 
+void HostOffloaderQueue::storageStateChange(bool isLowSpace)
+{
+    if (isStorageLow == isLowSpace)
+    {
+        return;
+    }
+    isStorageLow = isLowSpace;
+    if (isStorageLow)
+    {
+        logMsg<level::INFO>("Queue dump storage is low offloading largest "
+                            "dumps first");
+    }
+    else
+    {
+        logMsg<level::INFO>("Queue dump storage is normal");
+    }
+}
+
 void HostOffloaderQueue::hostStateChange(bool isRunning)
 {
+    if (isRunning && (!_isHostStateKnown || !isHostRunning))
+    {
+        // host boot is told from the power on time when the previous state
+        // is not known, on startup or on resume from dormant
+        bool isBooting = _isHostStateKnown;
+        _powerOnTimeRead = asyncGetPowerStateChangeTime(
+            _bus, [this, isBooting](std::optional<uint64_t> time) {
+                _history.hostRunning(time.value_or(0), isBooting);
+            });
+    }
+    _isHostStateKnown = true;
     isHostRunning = isRunning;
     if (isHostRunning)
     {
-        log<level::INFO>("Queue host state changed to running");
+        logMsg<level::INFO>("Queue host state changed to running");
         // dumps might have been queued while host is not running, offload them
         startTimer();
     }
     else
     {
-        log<level::INFO>("Queue host state changed to not running");
+        logMsg<level::INFO>("Queue host state changed to not running");
         stopTimer();
     }
 }
 
-void HostOffloaderQueue::hmcStateChange(bool isHMCManagedSystem)
+void HostOffloaderQueue::hmcStateChange(bool isHMCManaged)
 {
-    isHMCManagedSystem = isHMCManagedSystem;
+    isHMCManagedSystem = isHMCManaged;
     if (!isHMCManagedSystem)
     {
-        log<level::INFO>("Queue HMC state change non HMC managed system");
+        logMsg<level::INFO>("Queue HMC state change non HMC managed system");
         // dumps might have been queued while system is HMC managed, offload
         // them
         startTimer();
     }
     else
     {
-        log<level::INFO>("Queue HMC state change HMC managed system");
+        logMsg<level::INFO>("Queue HMC state change HMC managed system");
         stopTimer();
     }
 }
 
+void HostOffloaderQueue::release()
+{
+    isHMCManagedSystem = true;
+    stopTimer();
+    _scheduleEvent.set_enabled(sdeventplus::source::Enabled::Off);
+
+    // an announcement in flight is ignored on completion
+    _offloadDump.reset();
+    _announcedTime.reset();
+    _offloadInProgress = false;
+    _prefetchStage.stop();
+    _sizeReads.clear();
+    // host state is not watched while dormant
+    _isHostStateKnown = false;
+    for (const auto& dump : _offloadDumpList)
+    {
+        if (dump.size != 0 || dump.hashed)
+        {
+            _releasedDumps.emplace_back(dump);
+        }
+    }
+    std::sort(_releasedDumps.begin(), _releasedDumps.end(),
+              [](const QueuedDump& lhs, const QueuedDump& rhs) {
+                  return lhs.key < rhs.key;
+              });
+    _releasedDumps.shrink_to_fit();
+    logMsg<level::INFO>("Queue released ({}) dumps metadata kept of ({})",
+                        _offloadDumpList.size(), _releasedDumps.size());
+    std::vector<QueuedDump>().swap(_offloadDumpList);
+}
+
+void HostOffloaderQueue::dropReleasedMetadata()
+{
+    std::vector<QueuedDump>().swap(_releasedDumps);
+}
+
+void HostOffloaderQueue::restore(QueuedDump& dump)
+{
+    auto iter = std::lower_bound(
+        _releasedDumps.begin(), _releasedDumps.end(), dump.key,
+        [](const QueuedDump& released, const DumpKey& key) {
+            return released.key < key;
+        });
+    if (iter == _releasedDumps.end() || iter->key != dump.key)
+    {
+        return;
+    }
+    if (dump.size == 0 && iter->size != 0)
+    {
+        dump.size = iter->size;
+        dump.sizeRead = SizeRead::done;
+    }
+    if (!iter->hashed)
+    {
+        return;
+    }
+    dump.digest = iter->digest;
+    dump.hashed = true;
+    dump.duplicate = _dumpDigest.isRecentlyOffloaded(dump.digest);
+}
+
 void HostOffloaderQueue::offload()
 {
+    // key of the dump at the head of the queue, known once it is picked
+    std::optional<DumpKey> key;
     try
     {
         if (_offloadInProgress)
@@ -121,64 +237,666 @@ void HostOffloaderQueue::offload()
             // nothing to offload return
             return;
         }
+        if (_suspendCount > 0)
+        {
+            // dump removals are pending, the next dump might be deleted
+            return;
+        }
+        if (_transportCircuit.isOpen())
+        {
+            // transport is failing, wait for the backoff to expire
+            return;
+        }
 
-        auto iter = _offloadDumpList.begin();
-        _offloadObjPath = iter->first;
-        object_path path = _offloadObjPath;
-        uint32_t id = std::stoul(path.filename());
-        uint64_t size = getDumpSize(_bus, _offloadObjPath);
-        DumpType type = iter->second;
-        log<level::INFO>(
-            fmt::format("Queue offload initiating offload ({}) id ({}) "
-                        "type ({}) size ({})",
-                        _offloadObjPath, id, type, size)
-                .c_str());
-        openpower::dump::pldm::sendNewDumpCmd(id, type, size);
+        auto next = nextDump();
+        if (next == _offloadDumpList.end())
+        {
+            // offload of all the queued dump types is paused
+            return;
+        }
+        key = next->key;
+        if (next->sizeRead == SizeRead::none ||
+            next->sizeRead == SizeRead::pending)
+        {
+            // announced once the size is read
+            readSize(*next);
+            return;
+        }
+
+        _offloadDump = *key;
+        _announcedSize = 0;
+        _offloadWait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - next->queuedTime);
+        if (next->sizeRead == SizeRead::failed)
+        {
+            throw std::runtime_error("size of the dump not read");
+        }
+        uint64_t size = next->size;
+        logDump<level::INFO>(*_offloadDump, _offloadDumpList.size(),
+                             "Queue offload initiating offload id ({}) "
+                             "type ({}) size ({}) digest ({:016x})",
+                             _offloadDump->id, _offloadDump->type, size,
+                             next->digest);
         _offloadInProgress = true;
+        _announcedSize = size;
+        _transportCircuit.attempt();
+        announce(*key, size);
     }
     catch (const std::exception& ex)
     {
-        // PLDM could return error, if the current dump offloading is deleted
+        // size read could fail, if the current dump offloading is deleted
         // do not throw the error to the caller.
-        log<level::ERR>(fmt::format("Queue dump ({}) deleted/pldm error ({})",
-                                    _offloadObjPath, ex.what())
-                            .c_str());
+        if (!key)
+        {
+            logRateLimited<level::ERR>(_errorLogLimit,
+                                       "Queue offload error ({})", ex.what());
+            return;
+        }
+        logRateLimited<level::ERR>(_errorLogLimit,
+                                   "Queue dump id ({}) type ({}) "
+                                   "deleted/size read error ({})",
+                                   key->id, key->type, ex.what());
 
         // error, deque the dump from offloading
-        dequeue(_offloadObjPath);
+        dequeue(*key, OffloadStatus::failed);
     }
 }
 
-void HostOffloaderQueue::enqueue(const object_path& path, DumpType type)
+void HostOffloaderQueue::announce(const DumpKey& key, uint64_t size)
 {
-    log<level::INFO>(fmt::format("Queue enqueue dump ({}) size of Q ({})",
-                                 path.str, _offloadDumpList.size())
-                         .c_str());
-    _offloadDumpList.emplace(path.str, type);
+    // transport could block, with PLDM the EID read, instance id request
+    // and the socket operations, run it off the event loop
+    auto result = std::make_shared<AnnounceResult>();
+    _workerPool.post(
+        [transport = &_transport, key, size, result]() {
+            try
+            {
+                transport->announce(key, size);
+            }
+            catch (const TransportError& ex)
+            {
+                result->error = ex.what();
+                result->isTransportError = true;
+            }
+            catch (const std::exception& ex)
+            {
+                result->error = ex.what();
+            }
+        },
+        [this, key, result]() { announceCompleted(key, *result); }, true);
+}
+
+void HostOffloaderQueue::announceCompleted(const DumpKey& key,
+                                           const AnnounceResult& result)
+{
+    // request reached the host unless the transport failed
+    if (result.isTransportError)
+    {
+        if (_transportCircuit.getState() == CircuitBreaker::State::closed)
+        {
+            logMsg<level::ERR>("Queue transport failed, offload held "
+                               "back ({})",
+                               *result.error);
+        }
+        _transportCircuit.failure();
+        logRateLimited<level::ERR>(_errorLogLimit,
+                                   "Queue dump id ({}) type ({}) kept queued "
+                                   "retry in ({}) ms",
+                                   key.id, key.type,
+                                   _transportCircuit.getBackoff().count());
+    }
+    else
+    {
+        if (_transportCircuit.getState() != CircuitBreaker::State::closed)
+        {
+            logMsg<level::INFO>("Queue transport recovered");
+        }
+        _transportCircuit.success();
+    }
+
+    if (_offloadDump != key)
+    {
+        // dump is removed while being announced
+        return;
+    }
+    if (result.isTransportError)
+    {
+        // announce the dump again once the transport is back
+        _offloadDump.reset();
+        _offloadInProgress = false;
+        return;
+    }
+    if (result.error)
+    {
+        // host could return error, if the current dump offloading is deleted
+        logRateLimited<level::ERR>(_errorLogLimit,
+                                   "Queue dump id ({}) type ({}) "
+                                   "deleted/announce error ({})",
+                                   key.id, key.type, *result.error);
+
+        // error, deque the dump from offloading
+        dequeue(key, OffloadStatus::failed);
+        return;
+    }
+    _announcedTime = std::chrono::steady_clock::now();
+    _statusCallback(key, OffloadStatus::announced);
+
+    auto announced = find(key);
+    if (announced != _offloadDumpList.end() && announced->hashed)
+    {
+        _dumpDigest.offloaded(announced->digest);
+    }
+
+    _prefetchStage.start(
+        key, announced != _offloadDumpList.end() ? announced->size : 0);
+    auto lineUp = _offloadDumpList.end();
+    for (auto iter = _offloadDumpList.begin(); iter != _offloadDumpList.end();
+         ++iter)
+    {
+        if (iter->key == key || isPaused(iter->key.type))
+        {
+            continue;
+        }
+        if (lineUp == _offloadDumpList.end() || isBefore(*iter, *lineUp))
+        {
+            lineUp = iter;
+        }
+    }
+    if (lineUp != _offloadDumpList.end())
+    {
+        _prefetchStage.lineUp(lineUp->key);
+    }
+}
+
+void HostOffloaderQueue::enqueue(const DumpKey& key, uint64_t size)
+{
+    logDump<level::INFO>(key, _offloadDumpList.size(),
+                         "Queue enqueue dump id ({}) type ({}) size of Q ({})",
+                         key.id, key.type, _offloadDumpList.size());
+    auto iter = std::lower_bound(
+        _offloadDumpList.begin(), _offloadDumpList.end(), key,
+        [](const QueuedDump& dump, const DumpKey& key) {
+            return dump.key < key;
+        });
+    if (iter == _offloadDumpList.end() || iter->key != key)
+    {
+        iter = _offloadDumpList.insert(
+            iter, QueuedDump{key, size,
+                             size != 0 ? SizeRead::done : SizeRead::none});
+        restore(*iter);
+        _statusCallback(key, OffloadStatus::queued);
+    }
 
     // new dump ready to offload start timer, if not started
-    startTimer();
+    scheduleOffload();
 }
 
-void HostOffloaderQueue::dequeue(const object_path& path)
+void HostOffloaderQueue::enqueue(const std::vector<SizedDump>& dumps)
 {
-    log<level::INFO>(fmt::format("Queue dequeue ({}) size of Q ({})", path.str,
-                                 _offloadDumpList.size())
-                         .c_str());
-    if (_offloadObjPath == path) // succesfully offloaded
+    if (dumps.empty())
     {
-        log<level::INFO>(
-            fmt::format("Queue offloaded dump completed ({}) ", path.str)
-                .c_str());
-        _offloadObjPath.clear();
-        _offloadInProgress = false;
+        return;
+    }
+    // append and sort once for the whole batch
+    std::vector<SizedDump> sized;
+    sized.reserve(dumps.size());
+    for (const auto& dump : dumps)
+    {
+        if (find(dump.first) == _offloadDumpList.end())
+        {
+            sized.emplace_back(dump);
+        }
+    }
+    std::sort(sized.begin(), sized.end());
+    sized.erase(std::unique(sized.begin(), sized.end(),
+                            [](const SizedDump& lhs, const SizedDump& rhs) {
+                                return lhs.first == rhs.first;
+                            }),
+                sized.end());
+    DumpList added;
+    added.reserve(sized.size());
+    _offloadDumpList.reserve(_offloadDumpList.size() + sized.size());
+    for (const auto& [key, size] : sized)
+    {
+        added.emplace_back(key);
+        _offloadDumpList.emplace_back(QueuedDump{
+            key, size, size != 0 ? SizeRead::done : SizeRead::none});
+    }
+    std::inplace_merge(_offloadDumpList.begin(),
+                       _offloadDumpList.end() - added.size(),
+                       _offloadDumpList.end(),
+                       [](const QueuedDump& lhs, const QueuedDump& rhs) {
+                           return lhs.key < rhs.key;
+                       });
+    logMsg<level::INFO>("Queue enqueue ({}) dumps size of Q ({})",
+                        dumps.size(), _offloadDumpList.size());
+    for (const auto& key : added)
+    {
+        restore(*find(key));
+        _statusCallback(key, OffloadStatus::queued);
+    }
+
+    scheduleOffload();
+}
+
+void HostOffloaderQueue::dequeue(const DumpKey& key)
+{
+    // dump offloaded or deleted
+    dequeue(key, _offloadDump == key ? OffloadStatus::completed
+                                     : OffloadStatus::removed);
+}
+
+void HostOffloaderQueue::dequeue(const DumpKey& key, OffloadStatus status)
+{
+    logDump<level::INFO>(key, _offloadDumpList.size(),
+                         "Queue dequeue id ({}) type ({}) size of Q ({})",
+                         key.id, key.type, _offloadDumpList.size());
+    offloadRemoved(key, status);
+    auto iter = find(key);
+    if (iter != _offloadDumpList.end())
+    {
+        _offloadDumpList.erase(iter);
+        _statusCallback(key, status);
     }
-    _offloadDumpList.erase(path);
 
     // if no more dumps to offload stop the timer
+    scheduleOffload();
+}
+
+void HostOffloaderQueue::dequeue(const DumpList& keys)
+{
+    if (keys.empty())
+    {
+        return;
+    }
+    DumpList removed(keys);
+    std::sort(removed.begin(), removed.end());
+    DumpList dequeued;
+    std::erase_if(_offloadDumpList,
+                  [&removed, &dequeued](const QueuedDump& dump) {
+                      if (!std::binary_search(removed.begin(), removed.end(),
+                                              dump.key))
+                      {
+                          return false;
+                      }
+                      dequeued.emplace_back(dump.key);
+                      return true;
+                  });
+    for (const auto& key : dequeued)
+    {
+        _statusCallback(key, OffloadStatus::removed);
+    }
+    // dump deleted before the host marked it offloaded, the offload is
+    // neither completed nor failed and is not sampled or recorded
+    if (_offloadDump &&
+        std::binary_search(removed.begin(), removed.end(), *_offloadDump))
+    {
+        offloadRemoved(*_offloadDump, OffloadStatus::removed);
+    }
+    logMsg<level::INFO>("Queue dequeue ({}) dumps size of Q ({})", keys.size(),
+                        _offloadDumpList.size());
+
+    scheduleOffload();
+}
+
+std::vector<HostOffloaderQueue::QueuedDump>::iterator
+    HostOffloaderQueue::find(const DumpKey& key)
+{
+    auto iter = std::lower_bound(
+        _offloadDumpList.begin(), _offloadDumpList.end(), key,
+        [](const QueuedDump& dump, const DumpKey& key) {
+            return dump.key < key;
+        });
+    if (iter != _offloadDumpList.end() && iter->key == key)
+    {
+        return iter;
+    }
+    return _offloadDumpList.end();
+}
+
+bool HostOffloaderQueue::isBefore(const QueuedDump& lhs,
+                                  const QueuedDump& rhs) const
+{
+    if (lhs.priority != rhs.priority)
+    {
+        return lhs.priority > rhs.priority;
+    }
+    if (isStorageLow)
+    {
+        // largest dumps first so that the space is reclaimed at the earliest
+        return lhs.size > rhs.size;
+    }
+    // duplicates are offloaded only after the other dumps
+    return !lhs.duplicate && rhs.duplicate;
+}
+
+std::vector<HostOffloaderQueue::QueuedDump>::iterator
+    HostOffloaderQueue::nextDump()
+{
+    if (isStorageLow)
+    {
+        // sizes are read only when required for the selection, the dumps
+        // of which the size is being read are selected on their size once
+        // it is read
+        for (auto& dump : _offloadDumpList)
+        {
+            if (!isPaused(dump.key.type))
+            {
+                readSize(dump);
+            }
+        }
+    }
+    auto next = _offloadDumpList.end();
+    for (auto iter = _offloadDumpList.begin(); iter != _offloadDumpList.end();
+         ++iter)
+    {
+        if (isPaused(iter->key.type))
+        {
+            continue;
+        }
+        if (next == _offloadDumpList.end() || isBefore(*iter, *next))
+        {
+            next = iter;
+        }
+    }
+    return next;
+}
+
+std::vector<HostOffloaderQueue::DumpStatus>
+    HostOffloaderQueue::getStatus() const
+{
+    std::vector<const QueuedDump*> order;
+    order.reserve(_offloadDumpList.size());
+    uint64_t knownSize = 0;
+    size_t knownCount = 0;
+    for (const auto& dump : _offloadDumpList)
+    {
+        order.emplace_back(&dump);
+        if (dump.size != 0)
+        {
+            knownSize += dump.size;
+            ++knownCount;
+        }
+    }
+    auto isInFlight = [this](const QueuedDump& dump) {
+        return _offloadInProgress && _offloadDump == dump.key;
+    };
+    std::stable_sort(order.begin(), order.end(),
+                     [this, &isInFlight](const QueuedDump* lhs,
+                                         const QueuedDump* rhs) {
+                         if (isInFlight(*lhs) != isInFlight(*rhs))
+                         {
+                             return isInFlight(*lhs);
+                         }
+                         return isBefore(*lhs, *rhs);
+                     });
+
+    auto now = std::chrono::steady_clock::now();
+    uint64_t averageSize = knownCount > 0 ? knownSize / knownCount : 0;
+    std::chrono::milliseconds eta(0);
+    std::vector<DumpStatus> status;
+    status.reserve(order.size());
+    for (const auto* dump : order)
+    {
+        bool inFlight = isInFlight(*dump);
+        std::chrono::milliseconds startEta(0);
+        std::chrono::milliseconds completionEta(0);
+        if (inFlight)
+        {
+            completionEta = _throughput.getTransferTime(_announcedSize);
+            if (_announcedTime)
+            {
+                completionEta -=
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - *_announcedTime);
+            }
+            completionEta = std::max(completionEta, eta);
+            eta = completionEta;
+        }
+        else if (!isPaused(dump->key.type))
+        {
+            startEta = eta;
+            completionEta = eta + _throughput.getTransferTime(
+                                      dump->size != 0 ? dump->size
+                                                      : averageSize);
+            eta = completionEta;
+        }
+        status.emplace_back(DumpStatus{
+            dump->key, dump->size, dump->hashed ? dump->digest : 0,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - dump->queuedTime),
+            inFlight, dump->priority, startEta, completionEta});
+    }
+    return status;
+}
+
+bool HostOffloaderQueue::promote(const DumpKey& key)
+{
+    auto iter = find(key);
+    if (iter == _offloadDumpList.end())
+    {
+        return false;
+    }
+    iter->priority = ++_prioritySeq;
+    logDump<level::INFO>(key, _offloadDumpList.size(),
+                         "Queue promote dump id ({}) type ({})", key.id,
+                         key.type);
+    scheduleOffload();
+    return true;
+}
+
+bool HostOffloaderQueue::demote(const DumpKey& key)
+{
+    auto iter = find(key);
+    if (iter == _offloadDumpList.end())
+    {
+        return false;
+    }
+    iter->priority = -(++_prioritySeq);
+    logDump<level::INFO>(key, _offloadDumpList.size(),
+                         "Queue demote dump id ({}) type ({})", key.id,
+                         key.type);
+    scheduleOffload();
+    return true;
+}
+
+bool HostOffloaderQueue::cancel(const DumpKey& key)
+{
+    if (isInFlight(key) || find(key) == _offloadDumpList.end())
+    {
+        return false;
+    }
+    logDump<level::INFO>(key, _offloadDumpList.size(),
+                         "Queue cancel dump id ({}) type ({})", key.id,
+                         key.type);
+    dequeue(key, OffloadStatus::removed);
+    return true;
+}
+
+void HostOffloaderQueue::setPaused(DumpType type, bool paused)
+{
+    uint32_t mask = 1U << static_cast<uint32_t>(type);
+    if (paused)
+    {
+        _pausedTypes |= mask;
+    }
+    else
+    {
+        _pausedTypes &= ~mask;
+    }
+    logMsg<level::INFO>("Queue offload of type ({}) paused ({})", type,
+                        paused);
+    scheduleOffload();
+}
+
+bool HostOffloaderQueue::isPaused(DumpType type) const
+{
+    return (_pausedTypes & (1U << static_cast<uint32_t>(type))) != 0;
+}
+
+void HostOffloaderQueue::readSize(QueuedDump& dump)
+{
+    if (dump.sizeRead != SizeRead::none)
+    {
+        return;
+    }
+    dump.sizeRead = SizeRead::pending;
+    DumpKey key = dump.key;
+    auto slot = asyncGetDumpSize(
+        _bus, getDumpObjPath(key), [this, key](std::optional<uint64_t> size) {
+            auto iter = find(key);
+            if (iter != _offloadDumpList.end() &&
+                iter->sizeRead == SizeRead::pending)
+            {
+                // dump might have been deleted, a failed read is not retried
+                // and the dump is removed on the signal
+                iter->size = size.value_or(0);
+                iter->sizeRead = size ? SizeRead::done : SizeRead::failed;
+                scheduleOffload();
+            }
+            // reply is received, release the slot of the call
+            _sizeReads.erase(key);
+        });
+    // slot is not default constructible, it is moved in as returned
+    _sizeReads.insert_or_assign(key, std::move(slot));
+}
+
+void HostOffloaderQueue::digestCompleted(const DumpKey& key,
+                                         std::optional<uint64_t> digest)
+{
+    // worker is free for the next dump to be hashed
+    scheduleOffload();
+    auto iter = find(key);
+    if (iter == _offloadDumpList.end() || !digest)
+    {
+        // dump is removed while it was being hashed, or its file could not
+        // be read and it is not hashed again
+        return;
+    }
+    iter->digest = *digest;
+    iter->hashed = true;
+    iter->duplicate = _dumpDigest.isRecentlyOffloaded(*digest);
+    if (iter->duplicate)
+    {
+        logDump<level::INFO>(key, _offloadDumpList.size(),
+                             "Queue dump id ({}) type ({}) is identical to "
+                             "a recently offloaded dump digest ({:016x})",
+                             key.id, key.type, *digest);
+    }
+}
+
+void HostOffloaderQueue::hashNext()
+{
+    if (!_dumpDigest.isEnabled())
+    {
+        return;
+    }
+    // next dumps in the offload order, same ranked dumps in queue order,
+    // the first one is the next to be announced
+    std::vector<QueuedDump*> next;
+    next.reserve(digestLookahead + 2);
+    for (auto& dump : _offloadDumpList)
+    {
+        if (isPaused(dump.key.type) || _offloadDump == dump.key)
+        {
+            continue;
+        }
+        auto pos = std::find_if(next.begin(), next.end(),
+                                [this, &dump](const QueuedDump* other) {
+                                    return isBefore(dump, *other);
+                                });
+        next.insert(pos, &dump);
+        if (next.size() > digestLookahead + 1)
+        {
+            next.pop_back();
+        }
+    }
+    // hashing the dump next to be announced would only delay it
+    for (size_t i = 1; i < next.size(); ++i)
+    {
+        if (_dumpDigest.getPendingCount() >= digestJobCount)
+        {
+            break;
+        }
+        // a dump file which could not be read is not hashed again
+        if (!next[i]->hashed && !next[i]->hashRequested)
+        {
+            next[i]->hashRequested = true;
+            _dumpDigest.hash(next[i]->key);
+        }
+    }
+}
+
+void HostOffloaderQueue::offloadRemoved(DumpKey key, OffloadStatus status)
+{
+    if (_offloadDump == key)
+    {
+        logDump<level::INFO>(key, _offloadDumpList.size(),
+                             "Queue offload ended id ({}) type ({}) "
+                             "completed ({})",
+                             key.id, key.type,
+                             status == OffloadStatus::completed);
+        _offloadDump.reset();
+        _offloadInProgress = false;
+        _prefetchStage.stop();
+        std::chrono::milliseconds duration(0);
+        if (_announcedTime)
+        {
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - *_announcedTime);
+            _announcedTime.reset();
+            if (status == OffloadStatus::completed &&
+                _announcedSize >= throughputMinSampleSize &&
+                _throughput.sample(_announcedSize, duration))
+            {
+                _prefetchStage.setReadRate(_throughput.getRate());
+                logMsg<level::INFO>("Queue offload of ({}) bytes took ({}) "
+                                    "ms throughput ({}) bytes/s",
+                                    _announcedSize, duration.count(),
+                                    _throughput.getRate());
+            }
+        }
+        // a cancelled or deleted offload is neither completed nor failed
+        if (status == OffloadStatus::completed ||
+            status == OffloadStatus::failed)
+        {
+            _history.add(key, _announcedSize, _offloadWait, duration,
+                         status == OffloadStatus::completed
+                             ? history::Result::completed
+                             : history::Result::failed);
+        }
+    }
+}
+
+void HostOffloaderQueue::suspend()
+{
+    ++_suspendCount;
+}
+
+void HostOffloaderQueue::resume()
+{
+    if (_suspendCount > 0)
+    {
+        --_suspendCount;
+    }
+}
+
+void HostOffloaderQueue::scheduleOffload()
+{
+    _scheduleEvent.set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+
+void HostOffloaderQueue::schedulePass()
+{
     if (_offloadDumpList.empty())
     {
-        stopTimer();
+        if (_offloadTimer.isEnabled())
+        {
+            stopTimer();
+        }
+        return;
     }
+    hashNext();
+    startTimer();
 }
 } // namespace openpower::dump
@@ -1,12 +1,26 @@
 #pragma once
 
+#include "circuit_breaker.hpp"
+#include "dump_digest.hpp"
+#include "dump_key.hpp"
+#include "logging.hpp"
+#include "offload_history.hpp"
+#include "prefetch_stage.hpp"
+#include "throughput_estimator.hpp"
+#include "transport.hpp"
 #include "utility.hpp"
+#include "worker_pool.hpp"
 
+#include <chrono>
+#include <functional>
 #include <map>
+#include <optional>
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/source/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
+#include <string>
 
 namespace openpower::dump
 {
@@ -31,27 +45,86 @@ class HostOffloaderQueue
     HostOffloaderQueue& operator=(HostOffloaderQueue&&) = delete;
     virtual ~HostOffloaderQueue() = default;
 
+    /** @brief offload status of a dump */
+    enum class OffloadStatus
+    {
+        queued,
+        announced,
+        completed,
+        failed,
+        removed
+    };
+
+    /** @brief Callback invoked when the offload status of a dump changes */
+    using StatusCallback =
+        std::function<void(const DumpKey& key, OffloadStatus status)>;
+
+    /** @brief key of a dump and its size, 0 if the size is not known */
+    using SizedDump = std::pair<DumpKey, uint64_t>;
+
     /**
      * @brief Constructor
      * @param[in] bus - D-Bus to attach to
      * @param[in] event - event handler
+     * @param[in] transport - transport to announce the dumps on
+     * @param[in] statusCallback - invoked when a dump is queued, announced,
+     *                             offloaded, failed or removed
+     * @param[in] historyFile - file to keep the offload history in
+     * @param[in] historySize - offloads kept in the history, 0 for none
      */
-    HostOffloaderQueue(sdbusplus::bus::bus& bus, sdeventplus::Event& event);
+    HostOffloaderQueue(sdbusplus::bus::bus& bus, sdeventplus::Event& event,
+                       Transport& transport, StatusCallback statusCallback,
+                       const std::string& historyFile, uint32_t historySize);
 
     /**
      * @brief Queue the dumps for offloading
-     * @param[in] path - D-Bus path of the dump object
-     * @param[in] type - type of the dump to offload
+     * @param[in] key - key of the dump to offload
+     * @param[in] size - size of the dump if known else 0
      */
-    void enqueue(const object_path& path, DumpType type);
+    void enqueue(const DumpKey& key, uint64_t size = 0);
+
+    /**
+     * @brief Queue a batch of dumps for offloading
+     * @details Offload is scheduled once for the whole batch
+     * @param[in] dumps - keys of the dumps to offload and their sizes
+     */
+    void enqueue(const std::vector<SizedDump>& dumps);
 
     /**
      * @brief DeQueue the dump object from offloading
      *        Dequeue can happen after succesfull offload or when dump objects
      *        are deleted by redfish client
-     * @param[in] path - D-Bus path of the dump object
+     * @param[in] key - key of the dump
+     */
+    void dequeue(const DumpKey& key);
+
+    /**
+     * @brief DeQueue a batch of dump objects from offloading
+     * @details The dumps are deleted, one being offloaded is not completed
+     * @param[in] keys - keys of the dumps
+     */
+    void dequeue(const DumpList& keys);
+
+    /**
+     * @brief Suspend announcing dumps to the host
+     * @details Used while dump removals are pending so that dumps which are
+     *          already deleted are not announced. Calls are counted, offload
+     *          resumes once every suspend is matched by a resume.
+     */
+    void suspend();
+
+    /**
+     * @brief Resume announcing dumps to the host
+     */
+    void resume();
+
+    /**
+     * @brief Storage state change notification from storage watch
+     * @details When dump storage is low largest dumps are offloaded first
+     *          so that the space is reclaimed at the earliest.
+     * @param[in] isLowSpace - True if dump storage free space is low
      */
-    void dequeue(const object_path& path);
+    void storageStateChange(bool isLowSpace);
 
     /**
      * @brief Host state change notification form host state watch
@@ -61,11 +134,274 @@ class HostOffloaderQueue
 
     /**
      * @brief HMC state change notification form HMC state watch
-     * @param[in] isHMCManagedSystem - True if system is HMC managed
+     * @param[in] isHMCManaged - True if system is HMC managed
+     */
+    void hmcStateChange(bool isHMCManaged);
+
+    /** @brief status of a queued dump */
+    struct DumpStatus
+    {
+        /** @brief key of the dump */
+        DumpKey key;
+
+        /** @brief size of the dump, 0 if not yet read */
+        uint64_t size;
+
+        /** @brief content digest of the dump, 0 if not yet computed */
+        uint64_t digest;
+
+        /** @brief time since the dump is queued */
+        std::chrono::milliseconds waitTime;
+
+        /** @brief dump is announced and being offloaded */
+        bool inFlight;
+
+        /** @brief positive if promoted, negative if demoted else 0 */
+        int32_t priority;
+
+        /** @brief predicted time until the offload starts, 0 if in flight
+         *  or paused */
+        std::chrono::milliseconds startEta;
+
+        /** @brief predicted time until the offload completes, 0 if paused */
+        std::chrono::milliseconds completionEta;
+    };
+
+    /**
+     * @brief Get the status of the queued dumps
+     * @details Offload times are predicted from the estimated host
+     *          throughput, the average size of the queued dumps is assumed
+     *          for the dumps of which size is not yet read.
+     * @return status of the dumps in offload order
+     */
+    std::vector<DumpStatus> getStatus() const;
+
+    /**
+     * @brief Check if there is nothing queued or being offloaded
+     * @return true if idle else false
+     */
+    bool isIdle() const
+    {
+        return _offloadDumpList.empty() && !_offloadInProgress;
+    }
+
+    /**
+     * @brief Check if a dump is being offloaded
+     * @return true if offload is in progress else false
      */
-    void hmcStateChange(bool isHMCManagedSystem);
+    bool isOffloadInProgress() const
+    {
+        return _offloadInProgress;
+    }
+
+    /**
+     * @brief Check if the dump is the one being offloaded
+     * @param[in] key - key of the dump
+     * @return true if the dump is announced or being announced to the host
+     */
+    bool isInFlight(const DumpKey& key) const
+    {
+        return _offloadDump == key;
+    }
+
+    /**
+     * @brief Get the number of dumps queued
+     * @return number of dumps queued including the one being offloaded
+     */
+    size_t getDepth() const
+    {
+        return _offloadDumpList.size();
+    }
+
+    /**
+     * @brief Get the estimated rate of the host pulling the dumps
+     * @return bytes per second
+     */
+    uint64_t getThroughput() const
+    {
+        return _throughput.getRate();
+    }
+
+    /**
+     * @brief Offload the dump ahead of the other queued dumps, the dump
+     *        promoted last is offloaded first
+     * @param[in] key - key of the dump
+     * @return false if the dump is not queued
+     */
+    bool promote(const DumpKey& key);
+
+    /**
+     * @brief Offload the dump after the other queued dumps, the dump
+     *        demoted last is offloaded last
+     * @param[in] key - key of the dump
+     * @return false if the dump is not queued
+     */
+    bool demote(const DumpKey& key);
+
+    /**
+     * @brief Remove the dump from the queue without offloading it, the
+     *        dump being offloaded is not removed
+     * @param[in] key - key of the dump
+     * @return false if the dump is not queued or is being offloaded
+     */
+    bool cancel(const DumpKey& key);
+
+    /**
+     * @brief Pause or resume offload of a dump type, dumps of a paused type
+     *        stay queued
+     * @param[in] type - type of the dump
+     * @param[in] paused - true to pause, false to resume
+     */
+    void setPaused(DumpType type, bool paused);
+
+    /**
+     * @brief Check if offload of the dump type is paused
+     * @param[in] type - type of the dump
+     * @return true if paused else false
+     */
+    bool isPaused(DumpType type) const;
+
+    /**
+     * @brief Release the queue when the system becomes HMC managed
+     * @details Offload is stopped and the queue memory is freed. Size and
+     *          digest of the released dumps are kept so that they are not
+     *          read again when the dumps are queued on the transition back.
+     */
+    void release();
+
+    /**
+     * @brief Drop the metadata kept on release, called once the existing
+     *        dumps are queued again
+     */
+    void dropReleasedMetadata();
 
   private:
+    /** @brief state of the size read of a queued dump */
+    enum class SizeRead
+    {
+        none,
+        pending,
+        done,
+        failed
+    };
+
+    /** @brief dump queued for offload */
+    struct QueuedDump
+    {
+        /** @brief key of the dump */
+        DumpKey key;
+
+        /** @brief size of the dump, 0 if not yet read */
+        uint64_t size;
+
+        /** @brief state of the size read, a size is read only once */
+        SizeRead sizeRead = SizeRead::none;
+
+        /** @brief content digest of the dump, valid if hashed is set */
+        uint64_t digest = 0;
+
+        /** @brief set once the digest of the dump is computed */
+        bool hashed = false;
+
+        /** @brief set once the dump is given to be hashed */
+        bool hashRequested = false;
+
+        /** @brief dump is identical to a recently offloaded dump */
+        bool duplicate = false;
+
+        /** @brief positive if promoted, negative if demoted else 0 */
+        int32_t priority = 0;
+
+        /** @brief time at which the dump is queued */
+        std::chrono::steady_clock::time_point queuedTime =
+            std::chrono::steady_clock::now();
+    };
+
+    /**
+     * @brief DeQueue the dump object from offloading
+     * @param[in] key - key of the dump
+     * @param[in] status - offload status the dump is dequeued with
+     */
+    void dequeue(const DumpKey& key, OffloadStatus status);
+
+    /**
+     * @brief Find the dump in the queue
+     * @param[in] key - key of the dump
+     * @return iterator to the dump if found else end of the queue
+     */
+    std::vector<QueuedDump>::iterator find(const DumpKey& key);
+
+    /**
+     * @brief Get the next dump to offload
+     * @details Promoted dumps are offloaded first and demoted dumps last,
+     *          otherwise the first dump in the queue which is not a
+     *          duplicate of a recently offloaded dump, if dump storage is
+     *          low the largest dump in the queue. Dumps of the paused types
+     *          are skipped.
+     * @return iterator to the dump to offload, end if none can be offloaded
+     */
+    std::vector<QueuedDump>::iterator nextDump();
+
+    /**
+     * @brief Check if the dump is to be offloaded before the other dump
+     * @param[in] lhs - dump to check
+     * @param[in] rhs - dump to check against, queued after lhs if of the
+     *                  same rank
+     * @return true if lhs is offloaded first else false
+     */
+    bool isBefore(const QueuedDump& lhs, const QueuedDump& rhs) const;
+
+    /**
+     * @brief Read the size of the dump without blocking, scheduling pass
+     *        is run when the size is read
+     * @param[in] dump - dump of which the size is not known
+     */
+    void readSize(QueuedDump& dump);
+
+    /**
+     * @brief Restore the size and digest of a dump queued before release
+     * @param[in] dump - dump being queued
+     */
+    void restore(QueuedDump& dump);
+
+    /**
+     * @brief Hash the dumps in line behind the next one to offload which
+     *        are not hashed
+     * @details Hashing reads the whole dump file and can not be
+     *          interrupted. The dump next to be announced is not hashed,
+     *          the dumps behind it are hashed while it is offloaded. The
+     *          hashing jobs are limited to leave a worker to the
+     *          announcement and the prefetch.
+     */
+    void hashNext();
+
+    /**
+     * @brief Hashing of the dump is done
+     * @param[in] key - key of the dump
+     * @param[in] digest - content digest of the dump, nullopt if the dump
+     *                     file could not be read
+     */
+    void digestCompleted(const DumpKey& key, std::optional<uint64_t> digest);
+
+    /**
+     * @brief Clear the in progress offload if it is one of the dumps
+     *        removed from the queue
+     * @param[in] key - key of the dump removed
+     * @param[in] status - offload status the dump is removed with
+     */
+    void offloadRemoved(DumpKey key, OffloadStatus status);
+
+    /**
+     * @brief Request a scheduling pass, requests made before the pass runs
+     *        are coalesced into the single pass.
+     */
+    void scheduleOffload();
+
+    /**
+     * @brief Scheduling pass, start or stop the timer based on the queue
+     */
+    void schedulePass();
+
     /**
      * @brief Check the states and start the timer for offloading dumps
      */
@@ -81,6 +417,32 @@ class HostOffloaderQueue
      */
     void offload();
 
+    /**
+     * @brief Announce the dump to the host on the worker pool
+     * @param[in] key - key of the dump
+     * @param[in] size - size of the dump announced
+     */
+    void announce(const DumpKey& key, uint64_t size);
+
+    /** @brief Result of the dump announcement */
+    struct AnnounceResult
+    {
+        /** @brief error of the announcement, nullopt on success */
+        std::optional<std::string> error;
+
+        /** @brief request failed on the transport */
+        bool isTransportError = false;
+    };
+
+    /**
+     * @brief Announcement of the dump is completed
+     * @details Dump is kept queued on a transport failure and the transport
+     *          circuit is opened, on any other error the dump is dequeued.
+     * @param[in] key - key of the dump
+     * @param[in] result - result of the announcement
+     */
+    void announceCompleted(const DumpKey& key, const AnnounceResult& result);
+
     /** @brief timer expired offload any existing dumps */
     void timerExpired();
 
@@ -90,11 +452,47 @@ class HostOffloaderQueue
     /** @brief sdevent event handle */
     sdeventplus::Event& _event;
 
-    /** @brief map of property change request for the corresponding entry */
-    std::map<std::string, DumpType> _offloadDumpList;
+    /** @brief transport to announce the dumps on */
+    Transport& _transport;
+
+    /** @brief invoked when the offload status of a dump changes */
+    StatusCallback _statusCallback;
+
+    /** @brief dumps to offload, sorted by dump type and id */
+    std::vector<QueuedDump> _offloadDumpList;
+
+    /** @brief metadata of the released dumps, sorted by type and id */
+    std::vector<QueuedDump> _releasedDumps;
+
+    /** @brief pending size reads of the queued dumps */
+    std::map<DumpKey, sdbusplus::slot_t> _sizeReads;
+
+    /** @brief read of the power on time for the host epoch */
+    std::optional<sdbusplus::slot_t> _powerOnTimeRead;
+
+    /** @brief dump currently in offload */
+    std::optional<DumpKey> _offloadDump;
 
-    /** @brief dump object currently in offload */
-    std::string _offloadObjPath;
+    /** @brief last priority given on promote or demote */
+    int32_t _prioritySeq = 0;
+
+    /** @brief bit mask of the paused dump types */
+    uint32_t _pausedTypes = 0;
+
+    /** @brief size of the dump announced */
+    uint64_t _announcedSize = 0;
+
+    /** @brief time the dump in offload waited in the queue */
+    std::chrono::milliseconds _offloadWait{0};
+
+    /** @brief time at which the dump in offload is announced */
+    std::optional<std::chrono::steady_clock::time_point> _announcedTime;
+
+    /** @brief estimate of the host throughput from the completed offloads */
+    ThroughputEstimator _throughput;
+
+    /** @brief number of outstanding suspend requests */
+    size_t _suspendCount = 0;
 
     /** @brief Flag set when offload is in progress */
     bool _offloadInProgress = false;
@@ -102,8 +500,15 @@ class HostOffloaderQueue
     /** @brief Flag to indicate whether the host is in running state */
     bool isHostRunning = false;
 
+    /** @brief Flag set once the host state is received, a change to
+     *  running is then a host boot */
+    bool _isHostStateKnown = false;
+
     /** @brief Flag to indicate whether the system is HMC managed */
     bool isHMCManagedSystem = false;
+
+    /** @brief Flag to indicate whether the dump storage is low */
+    bool isStorageLow = false;
     /**
      * @brief Attempt dump offload at every 5 seconds
      */
@@ -118,5 +523,31 @@ class HostOffloaderQueue
      *  callbacks.
      */
     Timer<Monotonic> _offloadTimer;
+
+    /**
+     * @brief idle priority event to run the scheduling pass, it is
+     *  dispatched only after the pending D-Bus signals are processed so a
+     *  burst of enqueue/dequeue requests results in a single pass.
+     */
+    sdeventplus::source::Defer _scheduleEvent;
+
+    /** @brief rate limit of the offload failure messages */
+    logging::RateLimit _errorLogLimit;
+
+    /** @brief circuit of the transport, holds back the announcements
+     *  while the transport is failing */
+    CircuitBreaker _transportCircuit;
+
+    /** @brief worker pool for the blocking file and transport operations */
+    WorkerPool _workerPool;
+
+    /** @brief content digest of the queued dumps */
+    DumpDigest _dumpDigest;
+
+    /** @brief page cache prefetch of the dump read by the host */
+    PrefetchStage _prefetchStage;
+
+    /** @brief history of the completed and failed offloads */
+    history::Store _history;
 };
 } // namespace openpower::dump
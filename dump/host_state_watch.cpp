@@ -2,15 +2,14 @@
 
 #include "dbus_util.hpp"
 
-#include <fmt/format.h>
-
-#include <phosphor-logging/log.hpp>
+#include "logging.hpp"
+#include "signal_trace.hpp"
 
 namespace openpower::dump
 {
 using ::openpower::dump::utility::DBusPropertiesMap;
+using ::openpower::dump::logging::logMsg;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
 
 HostStateWatch::HostStateWatch(sdbusplus::bus::bus& bus,
                                HostOffloaderQueue& dumpQueue) :
@@ -30,39 +29,41 @@ void HostStateWatch::propertyChanged(sdbusplus::message::message& msg)
     std::string intf;
     DBusPropertiesMap propMap;
     msg.read(intf, propMap);
-    log<level::INFO>(
-        fmt::format("Host state propertiesChanged interface ({}) ", intf)
-            .c_str());
+    logMsg<level::INFO>("Host state propertiesChanged interface ({}) ", intf);
     for (auto prop : propMap)
     {
         if (prop.first == "BootProgress")
         {
+            bool isRunning = false;
             auto progress = std::get_if<std::string>(&prop.second);
             if (progress != nullptr)
             {
                 ProgressStages bootProgress =
                     sdbusplus::xyz::openbmc_project::State::Boot::server::
                         Progress::convertProgressStagesFromString(*progress);
-                if ((bootProgress == ProgressStages::SystemInitComplete) ||
+                isRunning =
+                    (bootProgress == ProgressStages::SystemInitComplete) ||
                     (bootProgress == ProgressStages::OSStart) ||
-                    (bootProgress == ProgressStages::OSRunning))
-                {
-                    log<level::INFO>("Host state changed to running");
-                    _dumpQueue.hostStateChange(true);
-                }
-                else
-                {
-                    log<level::INFO>("Host state changed to not running");
-                    _dumpQueue.hostStateChange(false);
-                }
-            }
-            else
-            {
-                log<level::INFO>("Host state changed to not running");
-                _dumpQueue.hostStateChange(false);
+                    (bootProgress == ProgressStages::OSRunning);
             }
+            trace::record(trace::Signal::hostState, DumpType::bmc, 0,
+                          isRunning);
+            hostStateChanged(isRunning);
         }
     }
 }
 
+void HostStateWatch::hostStateChanged(bool isRunning)
+{
+    if (isRunning)
+    {
+        logMsg<level::INFO>("Host state changed to running");
+    }
+    else
+    {
+        logMsg<level::INFO>("Host state changed to not running");
+    }
+    _dumpQueue.hostStateChange(isRunning);
+}
+
 } // namespace openpower::dump
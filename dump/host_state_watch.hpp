@@ -28,6 +28,12 @@ class HostStateWatch
      */
     HostStateWatch(sdbusplus::bus::bus& bus, HostOffloaderQueue& dumpQueue);
 
+    /**
+     * @brief Host state is changed
+     * @param[in] isRunning - True if host is in running state
+     */
+    void hostStateChanged(bool isRunning);
+
   private:
     /**
      * @brief Callback method for property change on the host state object
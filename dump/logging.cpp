@@ -0,0 +1,83 @@
+#include "logging.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+namespace openpower::dump::logging
+{
+namespace
+{
+/** @brief least severe level logged */
+std::atomic<level> logLevel{level::INFO};
+} // namespace
+
+void initLogLevel()
+{
+    const char* env = std::getenv("PVM_DUMP_OFFLOAD_LOG_LEVEL");
+    if (env == nullptr)
+    {
+        return;
+    }
+    char* end = nullptr;
+    auto value = std::strtol(env, &end, 10);
+    if (end == env || *end != '\0' ||
+        value < static_cast<long>(level::EMERG) ||
+        value > static_cast<long>(level::DEBUG))
+    {
+        logMsg<level::ERR>("Invalid log level ({}) ignored", env);
+        return;
+    }
+    setLogLevel(static_cast<level>(value));
+}
+
+level getLogLevel()
+{
+    return logLevel.load(std::memory_order_relaxed);
+}
+
+void setLogLevel(level lvl)
+{
+    logLevel.store(lvl, std::memory_order_relaxed);
+}
+
+const char* getDumpTypeName(DumpType type)
+{
+    switch (type)
+    {
+        case DumpType::bmc:
+            return "bmc";
+        case DumpType::hardware:
+            return "hardware";
+        case DumpType::hostboot:
+            return "hostboot";
+        case DumpType::sbe:
+            return "sbe";
+    }
+    return "unknown";
+}
+
+bool RateLimit::allow()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - _start >= _interval)
+    {
+        _start = now;
+        _count = 0;
+    }
+    if (_count < _burst)
+    {
+        ++_count;
+        return true;
+    }
+    ++_suppressed;
+    return false;
+}
+
+size_t RateLimit::takeSuppressed()
+{
+    auto suppressed = _suppressed;
+    _suppressed = 0;
+    return suppressed;
+}
+} // namespace openpower::dump::logging
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "dump_key.hpp"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <phosphor-logging/log.hpp>
+
+namespace openpower::dump::logging
+{
+using ::phosphor::logging::entry;
+using ::phosphor::logging::level;
+
+/**
+ * @brief Initialize the runtime log level from the environment
+ * @details PVM_DUMP_OFFLOAD_LOG_LEVEL is the syslog priority (0-7) of the
+ *          least severe message logged, default is INFO.
+ */
+void initLogLevel();
+
+/**
+ * @brief Get the runtime log level threshold
+ * @return least severe level logged
+ */
+level getLogLevel();
+
+/**
+ * @brief Set the runtime log level threshold
+ * @param[in] lvl - least severe level to log
+ */
+void setLogLevel(level lvl);
+
+/**
+ * @brief Get the name of the dump type to add to the journal fields
+ * @param[in] type - type of the dump
+ * @return name of the dump type
+ */
+const char* getDumpTypeName(DumpType type);
+
+/** @brief DEBUG messages are compiled in, defined by the build for the
+ *  library and its users alike */
+#ifdef PVM_OFFLOAD_DEBUG_LOG
+constexpr bool debugLogEnabled = true;
+#else
+constexpr bool debugLogEnabled = false;
+#endif
+
+/**
+ * @brief Check if messages of the level are logged
+ * @details DEBUG messages are compiled out unless enabled at build time
+ * @return true if the messages are to be logged
+ */
+template <level L>
+inline bool isLogEnabled()
+{
+    if constexpr (L == level::DEBUG && !debugLogEnabled)
+    {
+        return false;
+    }
+    else
+    {
+        return static_cast<int>(L) <= static_cast<int>(getLogLevel());
+    }
+}
+
+/**
+ * @class RateLimit
+ * @brief Limit the number of messages logged by a call site in an interval
+ */
+class RateLimit
+{
+  public:
+    RateLimit() = delete;
+    RateLimit(const RateLimit&) = delete;
+    RateLimit& operator=(const RateLimit&) = delete;
+    RateLimit(RateLimit&&) = delete;
+    RateLimit& operator=(RateLimit&&) = delete;
+    ~RateLimit() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] interval - interval over which the burst is allowed
+     * @param[in] burst - number of messages allowed in the interval
+     */
+    RateLimit(std::chrono::milliseconds interval, size_t burst) :
+        _interval(interval), _burst(burst)
+    {
+    }
+
+    /**
+     * @brief Check if one more message can be logged
+     * @return true if allowed, else the message is counted as suppressed
+     */
+    bool allow();
+
+    /**
+     * @brief Get and reset the count of messages suppressed
+     * @return number of messages suppressed since the last call
+     */
+    size_t takeSuppressed();
+
+  private:
+    /** @brief interval over which the burst is allowed */
+    const std::chrono::milliseconds _interval;
+
+    /** @brief number of messages allowed in the interval */
+    const size_t _burst;
+
+    /** @brief start of the current interval */
+    std::chrono::steady_clock::time_point _start{};
+
+    /** @brief messages logged in the current interval */
+    size_t _count = 0;
+
+    /** @brief messages suppressed */
+    size_t _suppressed = 0;
+};
+
+/**
+ * @brief Format and log a message, message is formatted into a stack
+ *        buffer and only if the level is enabled
+ * @param[in] fmtStr - format of the message
+ * @param[in] args - arguments of the message
+ */
+template <level L, typename... Args>
+void logMsg(fmt::format_string<Args...> fmtStr, Args&&... args)
+{
+    if (!isLogEnabled<L>())
+    {
+        return;
+    }
+    fmt::memory_buffer buf;
+    fmt::format_to(std::back_inserter(buf), fmtStr,
+                   std::forward<Args>(args)...);
+    buf.push_back('\0');
+    ::phosphor::logging::log<L>(buf.data());
+}
+
+/**
+ * @brief Format and log a dump message along with the DUMP_ID, DUMP_TYPE
+ *        and QUEUE_DEPTH journal fields
+ * @param[in] key - key of the dump
+ * @param[in] queueDepth - number of dumps in the queue
+ * @param[in] fmtStr - format of the message
+ * @param[in] args - arguments of the message
+ */
+template <level L, typename... Args>
+void logDump(const DumpKey& key, size_t queueDepth,
+             fmt::format_string<Args...> fmtStr, Args&&... args)
+{
+    if (!isLogEnabled<L>())
+    {
+        return;
+    }
+    fmt::memory_buffer buf;
+    fmt::format_to(std::back_inserter(buf), fmtStr,
+                   std::forward<Args>(args)...);
+    buf.push_back('\0');
+    ::phosphor::logging::log<L>(
+        buf.data(), entry("DUMP_ID=%u", key.id),
+        entry("DUMP_TYPE=%s", getDumpTypeName(key.type)),
+        entry("QUEUE_DEPTH=%zu", queueDepth));
+}
+
+/**
+ * @brief Format and log a message if allowed by the rate limit, count of
+ *        the messages suppressed is added to the next message logged
+ * @param[in] limit - rate limit of the call site
+ * @param[in] fmtStr - format of the message
+ * @param[in] args - arguments of the message
+ */
+template <level L, typename... Args>
+void logRateLimited(RateLimit& limit, fmt::format_string<Args...> fmtStr,
+                    Args&&... args)
+{
+    if (!isLogEnabled<L>() || !limit.allow())
+    {
+        return;
+    }
+    fmt::memory_buffer buf;
+    fmt::format_to(std::back_inserter(buf), fmtStr,
+                   std::forward<Args>(args)...);
+    auto suppressed = limit.takeSuppressed();
+    if (suppressed > 0)
+    {
+        fmt::format_to(std::back_inserter(buf),
+                       " ({} similar messages suppressed)", suppressed);
+    }
+    buf.push_back('\0');
+    ::phosphor::logging::log<L>(buf.data());
+}
+} // namespace openpower::dump::logging
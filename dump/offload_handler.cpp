@@ -3,67 +3,105 @@
 #include "offload_handler.hpp"
 
 #include "dbus_util.hpp"
+#include "logging.hpp"
 #include "utility.hpp"
 
-#include <fmt/format.h>
-
-#include <phosphor-logging/log.hpp>
-
 namespace openpower::dump
 {
+using ::openpower::dump::logging::logMsg;
 using ::openpower::dump::utility::DumpType;
-using ::openpower::dump::utility::ManagedObjectType;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
 
 OffloadHandler::OffloadHandler(sdbusplus::bus::bus& bus,
+                               sdeventplus::Event& event,
                                HostOffloaderQueue& dumpOffloader,
                                const std::string& entryIntf,
-                               const std::string& entryObjPath,
                                DumpType dumpType) :
     _bus(bus),
     _dumpOffloader(dumpOffloader), _entryIntf(entryIntf), _dumpType(dumpType),
-    _dumpWatch(bus, dumpOffloader, entryObjPath, dumpType)
+    _dumpWatch(event, dumpOffloader, dumpType)
 {
 }
 
-void OffloadHandler::offload()
+void OffloadHandler::offload(const ManagedObjectType& objects)
 {
     try
     {
-        auto objectPaths = getDumpEntryObjPaths(_bus, _entryIntf);
-        std::vector<std::string> inProgressDumps;
-        for (auto& path : objectPaths)
+        std::vector<uint32_t> inProgressDumps;
+        std::vector<HostOffloaderQueue::SizedDump> completedDumps;
+        for (const auto& [path, interfaces] : objects)
         {
-            bool fcomplete = isDumpProgressCompleted(_bus, path);
+            if (interfaces.find(_entryIntf) == interfaces.end())
+            {
+                // not a dump of this type
+                continue;
+            }
+            auto key = getDumpKey(_dumpType, path);
+            if (!key)
+            {
+                continue;
+            }
+            auto entry = interfaces.find(entryIntf);
+            if (entry != interfaces.end() && isDumpOffloaded(entry->second))
+            {
+                // already offloaded, waiting for the host to delete it
+                continue;
+            }
+            // size is used to prioritise the dumps when storage is low
+            uint64_t size = 0;
+            if (entry != interfaces.end())
+            {
+                size = getDumpSize(entry->second);
+            }
+            bool fcomplete = false;
+            auto progress = interfaces.find(progressIntf);
+            if (progress != interfaces.end())
+            {
+                fcomplete = isDumpProgressCompleted(progress->second);
+            }
             if (!fcomplete)
             {
-                log<level::INFO>(
-                    fmt::format("Offloader dump is not"
-                                " completed, adding to watcher ({})",
-                                path)
-                        .c_str());
-                inProgressDumps.emplace_back(path);
+                logMsg<level::INFO>("Offloader dump is not completed, adding "
+                                    "to watcher ({})",
+                                    path.str);
+                trace::record(trace::Signal::dumpAdded, _dumpType, key->id,
+                              false);
+                inProgressDumps.emplace_back(key->id);
                 continue;
             }
-            log<level::INFO>(
-                fmt::format("Offloader queue dump to offload ({})", path)
-                    .c_str());
-            // queue the dump for offloading
-            _dumpOffloader.enqueue(path, _dumpType);
+            logMsg<level::INFO>("Offloader queue dump to offload ({})",
+                                path.str);
+            trace::record(trace::Signal::dumpAdded, _dumpType, key->id, true,
+                          size);
+            completedDumps.emplace_back(*key, size);
 
         } // end for
 
+        // queue the completed dumps for offloading
+        _dumpOffloader.enqueue(completedDumps);
+
         // add any inprogress dumps to the watch list
-        _dumpWatch.addInProgressDumpsToWatch(std::move(inProgressDumps));
+        _dumpWatch.addInProgressDumpsToWatch(inProgressDumps);
     }
     catch (const std::exception& ex)
     {
-        log<level::ERR>(
-            fmt::format("Offloader failed to offload dump ex ({})", ex.what())
-                .c_str());
+        logMsg<level::ERR>("Offloader failed to offload dump ex ({})",
+                           ex.what());
         throw;
     }
 }
 
+void OffloadHandler::dispatch(const trace::Record& rec)
+{
+    if (rec.type == static_cast<uint8_t>(_dumpType))
+    {
+        _dumpWatch.dispatch(rec);
+    }
+}
+
+void OffloadHandler::release()
+{
+    _dumpWatch.release();
+}
+
 } // namespace openpower::dump
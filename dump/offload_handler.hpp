@@ -2,6 +2,7 @@
 
 #include "dump_watch.hpp"
 #include "host_offloader_queue.hpp"
+#include "signal_trace.hpp"
 #include "utility.hpp"
 
 #include <sdbusplus/bus.hpp>
@@ -9,6 +10,7 @@
 
 namespace openpower::dump
 {
+using ::openpower::dump::utility::ManagedObjectType;
 
 /**
  * @class OffloadHandler
@@ -31,20 +33,42 @@ class OffloadHandler
     /**
      * @brief constructor
      * @param[in] bus - D-Bus handle
+     * @param[in] event - event handler
      * @param[in] offloader - To queue and offload dump
      * @param[in] entryIntf - entry interface to watch
-     * @param[in] entryObjPath - entry object path to watch
      * @param[in] dumpType - type of the dump to watch
      */
-    OffloadHandler(sdbusplus::bus::bus& bus, HostOffloaderQueue& offloader,
-                   const std::string& entryIntf,
-                   const std::string& entryObjPath, DumpType dumpType);
+    OffloadHandler(sdbusplus::bus::bus& bus, sdeventplus::Event& event,
+                   HostOffloaderQueue& offloader, const std::string& entryIntf,
+                   DumpType dumpType);
 
     /**
-     * @brief Offload dump by sending request to PLDM
-     * @param[in] existing dump objects
+     * @brief Queue the completed dumps of this type for offload and add
+     *        watch on the dumps still in progress
+     * @param[in] objects - existing dump objects read from dump manager
      */
-    void offload();
+    void offload(const ManagedObjectType& objects);
+
+    /**
+     * @brief Handle a decoded dump signal, signals of the other dump types
+     *        are ignored
+     * @param[in] rec - record of the signal
+     */
+    void dispatch(const trace::Record& rec);
+
+    /**
+     * @brief Forget the watched dumps when the system becomes HMC managed
+     */
+    void release();
+
+    /**
+     * @brief Check if no dump of this type is in progress
+     * @return true if idle else false
+     */
+    bool isIdle() const
+    {
+        return _dumpWatch.isIdle();
+    }
 
   protected:
     /* @brief sdbusplus DBus bus connection. */
@@ -0,0 +1,215 @@
+#include "offload_history.hpp"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace openpower::dump::history
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+namespace
+{
+/** @brief history file header, magic and the format version */
+constexpr std::array<char, 8> historyMagic = {'P', 'V', 'M', 'H',
+                                              'S', 'T', '0', '1'};
+
+/**
+ * @brief Get the milliseconds as a record field, saturated
+ * @param[in] duration - duration
+ * @return milliseconds
+ */
+uint32_t toRecordTime(std::chrono::milliseconds duration)
+{
+    auto count = std::max<int64_t>(duration.count(), 0);
+    return static_cast<uint32_t>(std::min<int64_t>(
+        count, std::numeric_limits<uint32_t>::max()));
+}
+} // namespace
+
+Store::Store(const std::string& path, uint32_t capacity)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+    if (map(path, capacity))
+    {
+        logMsg<level::INFO>("History ({}) records ({}) of ({})", path,
+                            std::min<uint64_t>(_header->count, capacity),
+                            capacity);
+    }
+}
+
+Store::~Store()
+{
+    if (_header != nullptr)
+    {
+        munmap(_header, _mapSize);
+    }
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+}
+
+bool Store::isEnabled() const
+{
+    return _header != nullptr;
+}
+
+bool Store::map(const std::string& path, uint32_t capacity)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(
+        std::filesystem::path(path).parent_path(), ec);
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        logMsg<level::ERR>("History failed to open ({}) errno ({})", path,
+                           errno);
+        return false;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        // another process records to this file, the history is not shared
+        logMsg<level::ERR>("History ({}) is locked by another writer",
+                           path);
+        close(fd);
+        return false;
+    }
+    size_t mapSize = sizeof(Header) + sizeof(Record) * capacity;
+    struct stat st = {};
+    if (fstat(fd, &st) != 0)
+    {
+        logMsg<level::ERR>("History failed to stat ({}) errno ({})", path,
+                           errno);
+        close(fd);
+        return false;
+    }
+    bool isNew = static_cast<size_t>(st.st_size) != mapSize;
+    if (isNew && (ftruncate(fd, 0) != 0 ||
+                  ftruncate(fd, static_cast<off_t>(mapSize)) != 0))
+    {
+        logMsg<level::ERR>("History failed to size ({}) errno ({})", path,
+                           errno);
+        close(fd);
+        return false;
+    }
+    void* addr =
+        mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        logMsg<level::ERR>("History failed to map ({}) errno ({})", path,
+                           errno);
+        close(fd);
+        return false;
+    }
+    // descriptor is kept open to hold the lock while mapped
+    _fd = fd;
+    _header = static_cast<Header*>(addr);
+    _records = reinterpret_cast<Record*>(_header + 1);
+    _mapSize = mapSize;
+    if (!isNew &&
+        (_header->magic != historyMagic || _header->capacity != capacity))
+    {
+        isNew = true;
+        std::fill_n(static_cast<char*>(addr), mapSize, 0);
+    }
+    if (isNew)
+    {
+        // file created or of another capacity, the history is started over
+        logMsg<level::INFO>("History ({}) created records ({})", path,
+                            capacity);
+        _header->capacity = capacity;
+        _header->magic = historyMagic;
+    }
+    return true;
+}
+
+void Store::add(const DumpKey& key, uint64_t size,
+                std::chrono::milliseconds queueWait,
+                std::chrono::milliseconds transferTime, Result result)
+{
+    if (_header == nullptr)
+    {
+        return;
+    }
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    Record rec{};
+    rec.time = static_cast<uint64_t>(now.count());
+    rec.size = size;
+    rec.id = key.id;
+    rec.queueWait = toRecordTime(queueWait);
+    rec.transferTime = toRecordTime(transferTime);
+    rec.hostEpoch = _header->hostEpoch;
+    rec.type = static_cast<uint8_t>(key.type);
+    rec.result = result;
+    // record is complete before it is counted, a crash in between loses
+    // only the record
+    _records[_header->count % _header->capacity] = rec;
+    ++_header->count;
+}
+
+void Store::hostRunning(uint64_t powerOnTime, bool isBooting)
+{
+    if (_header == nullptr)
+    {
+        return;
+    }
+    // a restart of the process, or a resume from dormant, while the host is
+    // running finds the same power on time and does not start a new epoch
+    bool isPowerCycled =
+        powerOnTime != 0 && powerOnTime != _header->hostPowerOnTime;
+    if (!isBooting && !isPowerCycled)
+    {
+        return;
+    }
+    ++_header->hostEpoch;
+    if (powerOnTime != 0)
+    {
+        _header->hostPowerOnTime = powerOnTime;
+    }
+    logMsg<level::INFO>("History host epoch ({}) power on time ({})",
+                        _header->hostEpoch, _header->hostPowerOnTime);
+}
+
+std::vector<Record> load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    Header header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != historyMagic || header.capacity == 0)
+    {
+        throw std::runtime_error("not an offload history file");
+    }
+    std::vector<Record> ring(header.capacity);
+    if (!file.read(reinterpret_cast<char*>(ring.data()),
+                   static_cast<std::streamsize>(sizeof(Record) * ring.size())))
+    {
+        throw std::runtime_error("offload history file is truncated");
+    }
+    if (header.count <= header.capacity)
+    {
+        ring.resize(header.count);
+        return ring;
+    }
+    // ring is full, the oldest record is the next one to be overwritten
+    std::rotate(ring.begin(), ring.begin() + header.count % header.capacity,
+                ring.end());
+    return ring;
+}
+} // namespace openpower::dump::history
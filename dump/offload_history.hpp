@@ -0,0 +1,169 @@
+#pragma once
+
+#include "dump_key.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace openpower::dump::history
+{
+
+/** @brief Result of the offload */
+enum class Result : uint8_t
+{
+    completed,
+    failed
+};
+
+/**
+ * @struct Header
+ * @brief Header of the history file, followed by the ring of records
+ */
+struct Header
+{
+    /** @brief magic and the format version */
+    std::array<char, 8> magic;
+
+    /** @brief number of records in the ring */
+    uint32_t capacity;
+
+    /** @brief number of host boots seen */
+    uint32_t hostEpoch;
+
+    /** @brief number of records written since the file is created, the
+     *  next record is written at count modulo capacity */
+    uint64_t count;
+
+    /** @brief chassis power on time of the host epoch, milliseconds since
+     *  the Unix epoch, 0 if not known */
+    uint64_t hostPowerOnTime;
+};
+
+/**
+ * @struct Record
+ * @brief Record of a completed or failed offload
+ */
+struct Record
+{
+    /** @brief time the offload ended, milliseconds since the Unix epoch */
+    uint64_t time;
+
+    /** @brief size announced to the host, 0 if the size is not read */
+    uint64_t size;
+
+    /** @brief id of the dump */
+    uint32_t id;
+
+    /** @brief milliseconds the dump waited in the queue to be announced */
+    uint32_t queueWait;
+
+    /** @brief milliseconds from the announcement to the end of the offload,
+     *  0 if the dump is not announced */
+    uint32_t transferTime;
+
+    /** @brief host epoch the offload ended in */
+    uint32_t hostEpoch;
+
+    /** @brief DumpType of the dump */
+    uint8_t type;
+
+    /** @brief Result of the offload */
+    Result result;
+
+    /** @brief reserved, written as 0 */
+    std::array<uint8_t, 6> reserved;
+};
+
+/** @brief File is mapped as is, host byte order */
+static_assert(sizeof(Header) == 32, "history header layout changed");
+static_assert(sizeof(Record) == 40, "history record layout changed");
+
+/**
+ * @class Store
+ * @brief Bounded history of the offloads in a memory mapped ring file
+ * @details A record is a store to the mapping, no system call is made per
+ *  offload and the records survive a restart of the process. The oldest
+ *  record is overwritten once the ring is full. History is not kept if the
+ *  file can not be opened or is locked by another writer, offload is not
+ *  affected.
+ */
+class Store
+{
+  public:
+    Store() = delete;
+    Store(const Store&) = delete;
+    Store& operator=(const Store&) = delete;
+    Store(Store&&) = delete;
+    Store& operator=(Store&&) = delete;
+    virtual ~Store();
+
+    /**
+     * @brief Constructor, the file is created if not found or if it has a
+     *        different capacity
+     * @param[in] path - history file
+     * @param[in] capacity - number of records kept, 0 to keep no history
+     */
+    Store(const std::string& path, uint32_t capacity);
+
+    /**
+     * @brief Check if the history is kept
+     * @return true if the history file is mapped
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Add the record of an offload
+     * @param[in] key - key of the dump
+     * @param[in] size - size announced to the host
+     * @param[in] queueWait - time the dump waited in the queue
+     * @param[in] transferTime - time from the announcement to the end
+     * @param[in] result - result of the offload
+     */
+    void add(const DumpKey& key, uint64_t size,
+             std::chrono::milliseconds queueWait,
+             std::chrono::milliseconds transferTime, Result result);
+
+    /**
+     * @brief Host is running, a new host epoch is started if the host is
+     *        seen booting or if it was powered on since the epoch started
+     * @details The power on time identifies the boot across restarts of
+     *          the process, a reboot without a power cycle is seen only
+     *          while the process is running.
+     * @param[in] powerOnTime - chassis power on time, 0 if not known
+     * @param[in] isBooting - host is seen going from not running to running
+     */
+    void hostRunning(uint64_t powerOnTime, bool isBooting);
+
+  private:
+    /**
+     * @brief Open and map the history file
+     * @param[in] path - history file
+     * @param[in] capacity - number of records kept
+     * @return true if mapped
+     */
+    bool map(const std::string& path, uint32_t capacity);
+
+    /** @brief locked history file, -1 if the history is not kept */
+    int _fd = -1;
+
+    /** @brief mapped header, nullptr if the history is not kept */
+    Header* _header = nullptr;
+
+    /** @brief mapped ring of records */
+    Record* _records = nullptr;
+
+    /** @brief size of the mapping */
+    size_t _mapSize = 0;
+};
+
+/**
+ * @brief Read the records of a history file
+ * @param[in] path - history file
+ * @return records, oldest first
+ */
+std::vector<Record> load(const std::string& path);
+} // namespace openpower::dump::history
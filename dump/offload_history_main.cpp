@@ -0,0 +1,282 @@
+#include "config.h"
+
+#include "logging.hpp"
+#include "offload_history.hpp"
+
+#include <fmt/format.h>
+#include <getopt.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+using ::openpower::dump::DumpType;
+using ::openpower::dump::history::Record;
+using ::openpower::dump::history::Result;
+using ::openpower::dump::logging::getDumpTypeName;
+
+namespace
+{
+/** @brief percentiles reported of each distribution */
+constexpr std::array<unsigned, 3> percentiles = {50, 90, 99};
+
+/**
+ * @brief Get the nearest rank percentile of the values
+ * @param[in] sorted - values, sorted ascending
+ * @param[in] percentile - percentile, 0 to 100
+ * @return value at the percentile, 0 if there are no values
+ */
+uint64_t getPercentile(const std::vector<uint64_t>& sorted,
+                       unsigned percentile)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t rank = (sorted.size() * percentile + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+/**
+ * @struct Summary
+ * @brief Statistics of a group of offload records
+ */
+struct Summary
+{
+    /** @brief completed offloads */
+    uint64_t completed = 0;
+
+    /** @brief failed offloads */
+    uint64_t failed = 0;
+
+    /** @brief bytes of the completed offloads */
+    uint64_t bytes = 0;
+
+    /** @brief milliseconds of the completed offloads */
+    uint64_t transferTime = 0;
+
+    /** @brief queue wait of the offloads, milliseconds */
+    std::vector<uint64_t> queueWaits;
+
+    /** @brief transfer time of the completed offloads, milliseconds */
+    std::vector<uint64_t> transferTimes;
+
+    /** @brief size of the completed offloads */
+    std::vector<uint64_t> sizes;
+
+    /**
+     * @brief Add the record to the statistics
+     * @param[in] rec - offload record
+     */
+    void add(const Record& rec)
+    {
+        queueWaits.push_back(rec.queueWait);
+        if (rec.result != Result::completed)
+        {
+            ++failed;
+            return;
+        }
+        ++completed;
+        sizes.push_back(rec.size);
+        if (rec.transferTime != 0)
+        {
+            bytes += rec.size;
+            transferTime += rec.transferTime;
+            transferTimes.push_back(rec.transferTime);
+        }
+    }
+
+    /**
+     * @brief Get the throughput of the completed offloads
+     * @return bytes per second, 0 if none is timed
+     */
+    uint64_t getThroughput() const
+    {
+        return transferTime == 0 ? 0 : bytes * 1000 / transferTime;
+    }
+
+    /** @brief Sort the distributions for the percentiles */
+    void sort()
+    {
+        std::sort(queueWaits.begin(), queueWaits.end());
+        std::sort(transferTimes.begin(), transferTimes.end());
+        std::sort(sizes.begin(), sizes.end());
+    }
+};
+
+/**
+ * @brief Format the percentiles and the maximum of a distribution
+ * @param[in] sorted - values, sorted ascending
+ * @return formatted percentiles
+ */
+std::string formatDistribution(const std::vector<uint64_t>& sorted)
+{
+    std::string out;
+    for (auto percentile : percentiles)
+    {
+        out += fmt::format(" p{} {:>10}", percentile,
+                           getPercentile(sorted, percentile));
+    }
+    out += fmt::format(" max {:>10}", sorted.empty() ? 0 : sorted.back());
+    return out;
+}
+
+/**
+ * @brief Format the time of a record, UTC
+ * @param[in] time - milliseconds since the Unix epoch
+ * @return formatted time
+ */
+std::string formatTime(uint64_t time)
+{
+    std::time_t seconds = static_cast<std::time_t>(time / 1000);
+    std::tm tm{};
+    gmtime_r(&seconds, &tm);
+    std::array<char, 32> buf{};
+    std::strftime(buf.data(), buf.size(), "%Y-%m-%d %H:%M", &tm);
+    return buf.data();
+}
+
+/**
+ * @brief Print the per dump type statistics
+ * @param[in] records - offload records
+ */
+void printTypes(const std::vector<Record>& records)
+{
+    std::map<uint8_t, Summary> types;
+    for (const auto& rec : records)
+    {
+        types[rec.type].add(rec);
+    }
+    for (auto& [type, summary] : types)
+    {
+        summary.sort();
+        fmt::print("\n{} dumps: completed {} failed {} throughput {} "
+                   "bytes/s\n",
+                   getDumpTypeName(static_cast<DumpType>(type)),
+                   summary.completed, summary.failed,
+                   summary.getThroughput());
+        fmt::print("  queue wait ms   {}\n",
+                   formatDistribution(summary.queueWaits));
+        fmt::print("  transfer ms     {}\n",
+                   formatDistribution(summary.transferTimes));
+        fmt::print("  size bytes      {}\n", formatDistribution(summary.sizes));
+    }
+}
+
+/**
+ * @brief Print the throughput trend over time intervals
+ * @param[in] records - offload records, oldest first
+ * @param[in] interval - interval length, milliseconds
+ */
+void printTrend(const std::vector<Record>& records, uint64_t interval)
+{
+    std::map<uint64_t, Summary> intervals;
+    for (const auto& rec : records)
+    {
+        intervals[rec.time / interval].add(rec);
+    }
+    fmt::print("\n{:<16} {:>9} {:>7} {:>14} {:>12}\n", "interval (UTC)",
+               "completed", "failed", "bytes/s", "p90 transfer");
+    for (auto& [index, summary] : intervals)
+    {
+        summary.sort();
+        fmt::print("{:<16} {:>9} {:>7} {:>14} {:>12}\n",
+                   formatTime(index * interval), summary.completed,
+                   summary.failed, summary.getThroughput(),
+                   getPercentile(summary.transferTimes, 90));
+    }
+}
+
+/**
+ * @brief Print the throughput per host epoch
+ * @param[in] records - offload records
+ */
+void printEpochs(const std::vector<Record>& records)
+{
+    std::map<uint32_t, Summary> epochs;
+    for (const auto& rec : records)
+    {
+        epochs[rec.hostEpoch].add(rec);
+    }
+    fmt::print("\n{:<10} {:>9} {:>7} {:>14} {:>12}\n", "host epoch",
+               "completed", "failed", "bytes/s", "p90 wait");
+    for (auto& [epoch, summary] : epochs)
+    {
+        summary.sort();
+        fmt::print("{:<10} {:>9} {:>7} {:>14} {:>12}\n", epoch,
+                   summary.completed, summary.failed,
+                   summary.getThroughput(),
+                   getPercentile(summary.queueWaits, 90));
+    }
+}
+
+/**
+ * @brief Print the usage of the tool
+ * @param[in] name - name the tool is run as
+ */
+void usage(const char* name)
+{
+    fmt::print(stderr,
+               "Usage: {} [-f history file] [-i trend interval hours]\n"
+               "Percentiles of the queue wait, transfer time and size of the "
+               "offloads per dump type,\nthroughput trend over the intervals "
+               "and per host epoch.\n",
+               name);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string path = offloadHistoryFile;
+    uint64_t intervalHours = 24;
+    int opt = 0;
+    while ((opt = getopt(argc, argv, "f:i:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                path = optarg;
+                break;
+            case 'i':
+                intervalHours = std::strtoull(optarg, nullptr, 10);
+                if (intervalHours == 0)
+                {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Record> records;
+    try
+    {
+        records = openpower::dump::history::load(path);
+    }
+    catch (const std::exception& ex)
+    {
+        fmt::print(stderr, "{}: {}\n", path, ex.what());
+        return EXIT_FAILURE;
+    }
+    if (records.empty())
+    {
+        fmt::print("{}: no offloads recorded\n", path);
+        return EXIT_SUCCESS;
+    }
+
+    fmt::print("{}: {} offloads from {} to {} UTC\n", path, records.size(),
+               formatTime(records.front().time),
+               formatTime(records.back().time));
+    printTypes(records);
+    printTrend(records, intervalHours * 3600 * 1000);
+    printEpochs(records);
+    return EXIT_SUCCESS;
+}
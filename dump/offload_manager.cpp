@@ -3,46 +3,311 @@
 #include "offload_manager.hpp"
 
 #include "dbus_util.hpp"
+#include "logging.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+#include <systemd/sd-daemon.h>
+
 namespace openpower::dump
 {
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
 OffloadManager::OffloadManager(sdbusplus::bus::bus& bus,
-                               sdeventplus::Event& event) :
+                               sdbusplus::bus::bus& controlBus,
+                               sdeventplus::Event& event,
+                               Transport& transport,
+                               const std::string& historyFile,
+                               uint32_t historySize) :
     _bus(bus),
-    _dumpQueue(bus, event), _hostStateWatch(bus, _dumpQueue),
-    _hmcStateWatch(bus, _dumpQueue)
+    _controlBus(controlBus), _event(event),
+    _dumpQueue(bus, event, transport,
+               [this](const DumpKey& key,
+                      HostOffloaderQueue::OffloadStatus status) {
+                   ++_activityCount;
+                   _queueControl.statusChanged(key, status);
+                   _notifyEvent.set_enabled(
+                       sdeventplus::source::Enabled::OneShot);
+               },
+               historyFile, historySize),
+    _queueControl(bus, event, _dumpQueue),
+    _hostStateWatch(std::make_unique<HostStateWatch>(controlBus, _dumpQueue)),
+    _hmcStateWatch(controlBus,
+                   [this](bool isHMCManaged) {
+                       hmcStateChanged(isHMCManaged);
+                   }),
+    _storageWatch(std::make_unique<StorageWatch>(event, _dumpQueue)),
+    _notifyEvent(event,
+                 std::bind(std::mem_fn(&OffloadManager::notifyStatus), this))
 {
+    _notifyEvent.set_priority(SD_EVENT_PRIORITY_IDLE);
+    _notifyEvent.set_enabled(sdeventplus::source::Enabled::Off);
 
     // add bmc dump offload handler to the list of dump types to offload
     std::unique_ptr<OffloadHandler> bmcDump = std::make_unique<OffloadHandler>(
-        _bus, _dumpQueue, bmcEntryIntf, bmcEntryObjPath, DumpType::bmc);
+        _bus, _event, _dumpQueue, bmcEntryIntf, DumpType::bmc);
     _offloadHandlerList.push_back(std::move(bmcDump));
 
     // add host dump offload handler to the list of dump types to offload
     std::unique_ptr<OffloadHandler> hostbootDump =
-        std::make_unique<OffloadHandler>(_bus, _dumpQueue, hostbootEntryIntf,
-                                         hostbootEntryObjPath,
-                                         DumpType::hostboot);
+        std::make_unique<OffloadHandler>(_bus, _event, _dumpQueue,
+                                         hostbootEntryIntf, DumpType::hostboot);
     _offloadHandlerList.push_back(std::move(hostbootDump));
 
     // add sbe dump offload handler to the list of dump types to offload
     std::unique_ptr<OffloadHandler> sbeDump = std::make_unique<OffloadHandler>(
-        _bus, _dumpQueue, sbeEntryIntf, sbeEntryObjPath, DumpType::sbe);
+        _bus, _event, _dumpQueue, sbeEntryIntf, DumpType::sbe);
     _offloadHandlerList.push_back(std::move(sbeDump));
 
     // add hardware dump offload handler to the list of dump types to
     // offload
     std::unique_ptr<OffloadHandler> hardwareDump =
-        std::make_unique<OffloadHandler>(_bus, _dumpQueue, hardwareEntryIntf,
-                                         hardwareEntryObjPath,
-                                         DumpType::hardware);
+        std::make_unique<OffloadHandler>(_bus, _event, _dumpQueue,
+                                         hardwareEntryIntf, DumpType::hardware);
     _offloadHandlerList.push_back(std::move(hardwareDump));
 }
 
 void OffloadManager::offload()
 {
+    if (_pendingStartupCalls > 0)
+    {
+        // startup requests are already sent
+        return;
+    }
+    _isDormant = false;
+    if (idleExitTimeout > 0 && !_idleTimer)
+    {
+        _idleTimer = std::make_unique<Timer<Monotonic>>(
+            _event, std::bind(std::mem_fn(&OffloadManager::idleCheck), this),
+            std::chrono::seconds(idleExitTimeout));
+    }
+    if (!_hostStateWatch)
+    {
+        _hostStateWatch =
+            std::make_unique<HostStateWatch>(_controlBus, _dumpQueue);
+    }
+    if (!_storageWatch)
+    {
+        _storageWatch = std::make_unique<StorageWatch>(_event, _dumpQueue);
+    }
+    // dump signals are received on the signal thread, the matches are in
+    // place before the existing dump entries are read
+    _signalThread = std::make_unique<SignalThread>(
+        _event, [this](const trace::Record& rec) { dispatch(rec); });
+    _signalThread->start();
+
+    // send all the requests without waiting for the replies, startup time
+    // is bound by the slowest reply instead of sum of all the replies
+    sd_notify(0, "STATUS=Reading HMC state, host state and dump entries");
+    _startupTimings.clear();
+    _startupTime = std::chrono::steady_clock::now();
+    _pendingStartupCalls = 3;
+    _startupCalls.emplace_back(
+        asyncIsSystemHMCManaged(_controlBus, [this](bool isHMCManaged) {
+            _isHMCManaged = isHMCManaged;
+            startupPhaseCompleted("hmc state");
+        }));
+    _startupCalls.emplace_back(
+        asyncIsHostRunning(_controlBus, [this](bool isHostRunning) {
+            _isHostRunning = isHostRunning;
+            startupPhaseCompleted("host state");
+        }));
+    _startupCalls.emplace_back(asyncGetDumpEntryObjects(
+        _bus, [this](int error, const ManagedObjectType& objects) {
+            if (error < 0)
+            {
+                logMsg<level::ERR>("Manager failed to read dump entries ({})",
+                                   error);
+                _event.exit(EXIT_FAILURE);
+                return;
+            }
+            _dumpObjects = objects;
+            startupPhaseCompleted("dump entries");
+        }));
+}
+
+void OffloadManager::startupPhaseCompleted(const char* phase)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - _startupTime);
+    logMsg<level::INFO>("Manager startup phase ({}) completed in ({}) ms",
+                        phase, elapsed.count());
+    _startupTimings += fmt::format("{}{} {} ms",
+                                   _startupTimings.empty() ? "" : ", ", phase,
+                                   elapsed.count());
+    if (--_pendingStartupCalls == 0)
+    {
+        // slots of the completed calls are dropped, each resume from
+        // dormant sends the calls again; the slot of the call being
+        // completed is held by sd-bus until this callback returns
+        _startupCalls.clear();
+        startupCompleted();
+        _startupDuration =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - _startupTime);
+        logMsg<level::INFO>("Manager startup completed in ({}) ms",
+                            _startupDuration.count());
+        sd_notify(0, "READY=1");
+        notifyStatus();
+    }
+}
+
+void OffloadManager::notifyStatus()
+{
+    std::string status;
+    if (_isDormant)
+    {
+        status = "STATUS=Dormant, system is HMC managed";
+    }
+    else
+    {
+        status = fmt::format(
+            "STATUS=Queue depth {}{}, startup {} ms ({})",
+            _dumpQueue.getDepth(),
+            _dumpQueue.isOffloadInProgress() ? ", offload in progress" : "",
+            _startupDuration.count(), _startupTimings);
+        if (_signalThread)
+        {
+            auto counters = _signalThread->getCounters();
+            status += fmt::format(", property signals {} ({} not decoded, "
+                                  "{} not dispatched)",
+                                  counters.received, counters.decodesAvoided,
+                                  counters.wakeupsAvoided);
+        }
+    }
+    sd_notify(0, status.c_str());
+}
+
+void OffloadManager::startupCompleted()
+{
+    // Not offloading if system is HMC managed, stay dormant watching only
+    // the HMC state until the system is changed to non HMC managed
+    if (_isHMCManaged)
+    {
+        logMsg<level::INFO>("HMC managed system offload is dormant");
+        _dumpObjects.clear();
+        std::vector<trace::Record>().swap(_startupSignals);
+        enterDormant();
+        return;
+    }
+    trace::record(trace::Signal::hmcState, DumpType::bmc, 0, _isHMCManaged);
+    trace::record(trace::Signal::hostState, DumpType::bmc, 0, _isHostRunning);
+    _dumpQueue.hmcStateChange(_isHMCManaged);
+    _dumpQueue.hostStateChange(_isHostRunning);
+
+    for (auto& dump : _offloadHandlerList)
+    {
+        dump->offload(_dumpObjects);
+    }
+    _dumpObjects.clear();
+
+    // dump signals received while the startup reads were pending are
+    // applied on top of the dump entries read, a change already seen in
+    // the entries read is applied again without effect
+    std::vector<trace::Record> signals;
+    signals.swap(_startupSignals);
+    for (const auto& rec : signals)
+    {
+        dispatch(rec);
+    }
+    _dumpQueue.dropReleasedMetadata();
+}
+
+void OffloadManager::hmcStateChanged(bool isHMCManaged)
+{
+    if (_pendingStartupCalls > 0)
+    {
+        // change is newer than the state being read, applied on startup
+        // completion
+        _isHMCManaged = isHMCManaged;
+        return;
+    }
+    if (isHMCManaged && !_isDormant)
+    {
+        enterDormant();
+    }
+    else if (!isHMCManaged && _isDormant)
+    {
+        // dumps created or deleted while dormant are not known, enumerate
+        // the dumps again, size and digest of the released dumps are reused
+        logMsg<level::INFO>("Non HMC managed system offload is resumed");
+        offload();
+    }
+    else
+    {
+        _dumpQueue.hmcStateChange(isHMCManaged);
+    }
+}
+
+void OffloadManager::idleCheck()
+{
+    // stay resident while dumps are in progress, their completion does not
+    // start the process again, and while dormant to watch the HMC state
+    bool isIdle = _pendingStartupCalls == 0 && !_isDormant &&
+                  _dumpQueue.isIdle() &&
+                  std::all_of(_offloadHandlerList.begin(),
+                              _offloadHandlerList.end(),
+                              [](const auto& dump) { return dump->isIdle(); });
+    if (!isIdle)
+    {
+        _idleActivityCount.reset();
+        return;
+    }
+    if (_idleActivityCount == _activityCount)
+    {
+        logMsg<level::INFO>("Manager idle for ({}) seconds exiting",
+                            idleExitTimeout);
+        _event.exit(EXIT_SUCCESS);
+        return;
+    }
+    _idleActivityCount = _activityCount;
+}
+
+void OffloadManager::enterDormant()
+{
+    _isDormant = true;
+    _notifyEvent.set_enabled(sdeventplus::source::Enabled::OneShot);
+    _signalThread.reset();
+    _hostStateWatch.reset();
+    _storageWatch.reset();
     for (auto& dump : _offloadHandlerList)
     {
-        dump->offload();
+        dump->release();
+    }
+    _dumpQueue.release();
+}
+
+void OffloadManager::dispatch(const trace::Record& rec)
+{
+    switch (rec.signal)
+    {
+        case trace::Signal::hostState:
+            if (_hostStateWatch)
+            {
+                _hostStateWatch->hostStateChanged(rec.flag);
+            }
+            break;
+        case trace::Signal::hmcState:
+            _hmcStateWatch.hmcStateChanged(rec.flag);
+            break;
+        default:
+            if (_pendingStartupCalls > 0)
+            {
+                // dump entries are being read, the signal is applied once
+                // the existing dumps are queued
+                _startupSignals.push_back(rec);
+                break;
+            }
+            for (auto& dump : _offloadHandlerList)
+            {
+                dump->dispatch(rec);
+            }
+            break;
     }
 }
 } // namespace openpower::dump
@@ -4,10 +4,20 @@
 #include "host_offloader_queue.hpp"
 #include "host_state_watch.hpp"
 #include "offload_handler.hpp"
+#include "queue_control.hpp"
+#include "signal_thread.hpp"
+#include "signal_trace.hpp"
+#include "storage_watch.hpp"
+#include "transport.hpp"
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdeventplus/clock.hpp>
 #include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
 namespace openpower::dump
 {
@@ -30,29 +40,142 @@ class OffloadManager
     /**
      * @brief Constructor
      * @param[in] bus - D-Bus to attach to.
+     * @param[in] controlBus - D-Bus connection for the host and HMC state,
+     *                         dispatched ahead of the dump signals
      * @param[in] event - event handler
+     * @param[in] transport - transport to announce the dumps on
+     * @param[in] historyFile - file to keep the offload history in
+     * @param[in] historySize - offloads kept in the history, 0 for none
      */
-    OffloadManager(sdbusplus::bus::bus& bus, sdeventplus::Event& event);
+    OffloadManager(sdbusplus::bus::bus& bus, sdbusplus::bus::bus& controlBus,
+                   sdeventplus::Event& event, Transport& transport,
+                   const std::string& historyFile, uint32_t historySize);
 
     /**
      * @brief Offload dumps existing on the system by sending PLDM request
+     * @details The dump signal thread is started, then the HMC state, host
+     *          state and the existing dump entries are requested
+     *          concurrently, offload starts once all the replies are
+     *          received. Dump signals received in the meantime are held
+     *          and applied after the existing dumps are queued. If the
+     *          system is HMC managed the manager stays dormant until the
+     *          system is no longer HMC managed. When built with an idle
+     *          exit timeout the process exits once there is nothing to
+     *          offload, it is started again on dump creation.
      */
     void offload();
 
+    /**
+     * @brief Handle a decoded signal, from the signal thread or replayed
+     *        from a trace
+     * @param[in] rec - record of the signal
+     */
+    void dispatch(const trace::Record& rec);
+
   private:
+    /**
+     * @brief Called when a startup request is completed
+     * @param[in] phase - name of the startup phase completed
+     */
+    void startupPhaseCompleted(const char* phase);
+
+    /**
+     * @brief Called when all startup requests are completed, queues the
+     *        existing dumps for offload
+     */
+    void startupCompleted();
+
+    /**
+     * @brief HMC state change notification from HMC state watch
+     * @param[in] isHMCManaged - True if system is HMC managed
+     */
+    void hmcStateChanged(bool isHMCManaged);
+
+    /**
+     * @brief Report the state of the offload to the service manager
+     */
+    void notifyStatus();
+
+    /**
+     * @brief Exit the process if it was idle since the last check
+     */
+    void idleCheck();
+
+    /**
+     * @brief Enter dormant mode, only the HMC state is watched
+     * @details Dump signal thread, host state and storage watches are
+     *          stopped and the queue memory is released.
+     */
+    void enterDormant();
+
     /** @brief D-Bus to connect to */
     sdbusplus::bus::bus& _bus;
 
+    /** @brief D-Bus connection for the host and HMC state */
+    sdbusplus::bus::bus& _controlBus;
+
+    /** @brief sdevent event handle */
+    sdeventplus::Event& _event;
+
     /** @brief Queue to offload dump requests */
     HostOffloaderQueue _dumpQueue;
 
+    /*@brief D-Bus control object of the queue */
+    QueueControl _queueControl;
+
     /*@brief list of dump offload objects */
     std::vector<std::unique_ptr<OffloadHandler>> _offloadHandlerList;
 
-    /*@brief watch for host state change */
-    HostStateWatch _hostStateWatch;
+    /*@brief watch for host state change, not present while dormant */
+    std::unique_ptr<HostStateWatch> _hostStateWatch;
 
     /*@brief watch for HMC state change */
     HMCStateWatch _hmcStateWatch;
+
+    /*@brief watch for dump storage free space, not present while dormant */
+    std::unique_ptr<StorageWatch> _storageWatch;
+
+    /*@brief thread receiving and decoding the dump signals */
+    std::unique_ptr<SignalThread> _signalThread;
+
+    /*@brief pending startup requests, cleared once all are completed */
+    std::vector<sdbusplus::slot_t> _startupCalls;
+
+    /*@brief timer to check for idle exit, not present if disabled */
+    std::unique_ptr<Timer<Monotonic>> _idleTimer;
+
+    /*@brief number of dump status changes, activity since the last check */
+    size_t _activityCount = 0;
+
+    /*@brief activity count at the last idle check, nullopt if not idle */
+    std::optional<size_t> _idleActivityCount;
+
+    /*@brief set while the system is HMC managed and offload is dormant */
+    bool _isDormant = false;
+
+    /*@brief number of startup requests yet to complete */
+    size_t _pendingStartupCalls = 0;
+
+    /*@brief time at which startup requests are sent */
+    std::chrono::steady_clock::time_point _startupTime;
+
+    /*@brief durations of the startup phases to report in the status */
+    std::string _startupTimings;
+
+    /*@brief duration of the last startup */
+    std::chrono::milliseconds _startupDuration{0};
+
+    /*@brief idle priority event to report the status, status changes of
+     *  a burst of dumps result in a single report */
+    sdeventplus::source::Defer _notifyEvent;
+
+    /*@brief startup results, valid once all the requests are completed */
+    bool _isHMCManaged = false;
+    bool _isHostRunning = false;
+    ManagedObjectType _dumpObjects;
+
+    /*@brief dump signals received while the startup requests are pending,
+     *  dispatched once the existing dumps are queued */
+    std::vector<trace::Record> _startupSignals;
 };
 } // namespace openpower::dump
@@ -0,0 +1,102 @@
+#include "path_trie.hpp"
+
+#include "dump_key.hpp"
+
+#include <algorithm>
+
+namespace openpower::dump
+{
+namespace
+{
+/**
+ * @brief Split the next element off the path
+ * @param[in,out] path - path, the element and its separator are removed
+ * @return path element, empty if the path is consumed
+ */
+std::string_view nextElement(std::string_view& path)
+{
+    while (path.starts_with('/'))
+    {
+        path.remove_prefix(1);
+    }
+    auto pos = path.find('/');
+    auto element = path.substr(0, pos);
+    path.remove_prefix(pos == std::string_view::npos ? path.size() : pos);
+    return element;
+}
+
+/** @brief Compare a trie child by its path element */
+struct ElementLess
+{
+    bool operator()(const std::pair<std::string, uint32_t>& child,
+                    std::string_view element) const
+    {
+        return std::string_view(child.first) < element;
+    }
+};
+} // namespace
+
+PathTrie::PathTrie(std::initializer_list<DumpType> types) : _nodes(1)
+{
+    for (auto type : types)
+    {
+        std::string_view path = getEntryObjPath(type);
+        uint32_t index = 0;
+        for (auto element = nextElement(path); !element.empty();
+             element = nextElement(path))
+        {
+            auto child = findChild(_nodes[index], element);
+            if (!child)
+            {
+                auto& children = _nodes[index].children;
+                auto it = std::lower_bound(children.begin(), children.end(),
+                                           element, ElementLess());
+                child = static_cast<uint32_t>(_nodes.size());
+                children.emplace(it, std::string(element), *child);
+                // may reallocate, no node references are held across it
+                _nodes.emplace_back();
+            }
+            index = *child;
+        }
+        _nodes[index].type = type;
+    }
+}
+
+std::optional<DumpType> PathTrie::find(std::string_view path) const
+{
+    uint32_t index = 0;
+    for (auto element = nextElement(path); !element.empty();
+         element = nextElement(path))
+    {
+        const auto& node = _nodes[index];
+        if (node.type)
+        {
+            // entry path is followed by the dump id and nothing else
+            if (nextElement(path).empty())
+            {
+                return node.type;
+            }
+            return std::nullopt;
+        }
+        auto child = findChild(node, element);
+        if (!child)
+        {
+            return std::nullopt;
+        }
+        index = *child;
+    }
+    return std::nullopt;
+}
+
+std::optional<uint32_t> PathTrie::findChild(const Node& node,
+                                            std::string_view element) const
+{
+    auto it = std::lower_bound(node.children.begin(), node.children.end(),
+                               element, ElementLess());
+    if (it == node.children.end() || it->first != element)
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+} // namespace openpower::dump
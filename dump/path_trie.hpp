@@ -0,0 +1,72 @@
+#pragma once
+
+#include "utility.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace openpower::dump
+{
+using ::openpower::dump::utility::DumpType;
+
+/**
+ * @class PathTrie
+ * @brief Map the dump entry object paths to the dump type
+ * @details The entry object paths of the dump types are split into path
+ *          elements and built into a trie once, a signal path is routed to
+ *          its dump type in a single walk of the path instead of comparing
+ *          it against the entry path of every dump type.
+ */
+class PathTrie
+{
+  public:
+    PathTrie() = delete;
+    PathTrie(const PathTrie&) = delete;
+    PathTrie& operator=(const PathTrie&) = delete;
+    PathTrie(PathTrie&&) = delete;
+    PathTrie& operator=(PathTrie&&) = delete;
+    virtual ~PathTrie() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] types - dump types to route, by their entry object path
+     */
+    explicit PathTrie(std::initializer_list<DumpType> types);
+
+    /**
+     * @brief Find the dump type of the entry object path
+     * @param[in] path - D-Bus object path
+     * @return dump type, nullopt if the path is not the entry path of a dump
+     *         type followed by a single path element
+     */
+    std::optional<DumpType> find(std::string_view path) const;
+
+  private:
+    /** @brief Node of the trie, one per path element */
+    struct Node
+    {
+        /** @brief child path elements and node indexes, sorted by element */
+        std::vector<std::pair<std::string, uint32_t>> children;
+
+        /** @brief dump type if the node is the end of an entry path */
+        std::optional<DumpType> type;
+    };
+
+    /**
+     * @brief Find the child node of the path element
+     * @param[in] node - parent node
+     * @param[in] element - path element
+     * @return index of the child node, nullopt if there is none
+     */
+    std::optional<uint32_t> findChild(const Node& node,
+                                      std::string_view element) const;
+
+    /** @brief nodes of the trie, the root is the first node */
+    std::vector<Node> _nodes;
+};
+} // namespace openpower::dump
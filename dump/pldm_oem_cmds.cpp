@@ -1,5 +1,6 @@
 #include "pldm_oem_cmds.hpp"
 
+#include "logging.hpp"
 #include "pldm_utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
@@ -16,6 +17,7 @@
 namespace openpower::dump::pldm
 {
 using namespace phosphor::logging;
+using ::openpower::dump::logging::logMsg;
 
 constexpr auto eidPath = "/usr/share/pldm/host_eid";
 constexpr mctp_eid_t defaultEIDValue = 9;
@@ -32,9 +34,8 @@ mctp_eid_t readEID()
     std::ifstream eidFile{eidPath};
     if (!eidFile.good())
     {
-        log<level::ERR>("Could not open host EID file");
-        elog<NotAllowed>(Reason("Required host dump action via pldm is not "
-                                "allowed due to mctp end point read failed"));
+        logMsg<level::ERR>("Could not open host EID file");
+        throw TransportError("MCTP end point read failed");
     }
     else
     {
@@ -46,10 +47,8 @@ mctp_eid_t readEID()
         }
         else
         {
-            log<level::ERR>("EID file was empty");
-            elog<NotAllowed>(
-                Reason("Required host dump action via pldm is not "
-                       "allowed due to mctp end point read failed"));
+            logMsg<level::ERR>("EID file was empty");
+            throw TransportError("MCTP end point read failed");
         }
     }
 
@@ -67,23 +66,20 @@ void newFileAvailable(uint32_t dumpId, pldm_fileio_file_type pldmDumpType,
     mctp_eid_t mctpEndPointId = internal::readEID();
 
     auto pldmInstanceId = getPLDMInstanceID(mctpEndPointId);
-    log<level::INFO>(
-        fmt::format("encode_new_file_req Instance ID ({}) "
-                    "DumpID ({}) DumpType ({}) DumpSize({})  ReqMsgSize({})",
-                    pldmInstanceId, dumpId, pldmDumpType, dumpSize,
-                    newFileAvailReqMsg.size())
-            .c_str());
+    logMsg<level::INFO>("encode_new_file_req Instance ID ({}) "
+                        "DumpID ({}) DumpType ({}) DumpSize({})  "
+                        "ReqMsgSize({})",
+                        pldmInstanceId, dumpId, pldmDumpType, dumpSize,
+                        newFileAvailReqMsg.size());
     int retCode = encode_new_file_req(
         pldmInstanceId, pldmDumpType, dumpId, dumpSize,
         reinterpret_cast<pldm_msg*>(newFileAvailReqMsg.data()));
     if (retCode != PLDM_SUCCESS)
     {
-        log<level::ERR>(
-            fmt::format(
-                "Failed to encode pldm New file req for new dump available "
-                "dumpId({}), pldmDumpType({}),rc({})",
-                dumpId, pldmDumpType, retCode)
-                .c_str());
+        logMsg<level::ERR>(
+            "Failed to encode pldm New file req for new dump available "
+            "dumpId({}), pldmDumpType({}),rc({})",
+            dumpId, pldmDumpType, retCode);
         elog<NotAllowed>(Reason(
             "Acknowledging new file request failed due to encoding error"));
     }
@@ -95,16 +91,15 @@ void newFileAvailable(uint32_t dumpId, pldm_fileio_file_type pldmDumpType,
     if (retCode != PLDM_REQUESTER_SUCCESS)
     {
         auto errorNumber = errno;
-        log<level::ERR>(
-            fmt::format(
-                "Failed to send pldm new file request for new dump available, "
-                "dumpId({}), pldmDumpType({}), "
-                "rc({}), errno({}), errmsg({})",
-                dumpId, pldmDumpType, retCode, errorNumber,
-                strerror(errorNumber))
-                .c_str());
-        elog<NotAllowed>(Reason("New file available  via pldm is not "
-                                "allowed due to new file request send failed"));
+        logMsg<level::ERR>(
+            "Failed to send pldm new file request for new dump available, "
+            "dumpId({}), pldmDumpType({}), "
+            "rc({}), errno({}), errmsg({})",
+            dumpId, pldmDumpType, retCode, errorNumber,
+            strerror(errorNumber));
+        throw TransportError(fmt::format("New file request send failed "
+                                         "rc({}), errno({})",
+                                         retCode, errorNumber));
     }
 }
 } // namespace openpower::dump::pldm
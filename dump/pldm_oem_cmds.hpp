@@ -1,20 +1,31 @@
 #pragma once
 
+#include "transport.hpp"
+
 #include <libpldm/file_io.h>
 #include <libpldm/pldm.h>
 
+#include <stdexcept>
+
 namespace openpower::dump::pldm
 {
+
+/** @brief PLDM request failed on the transport */
+using TransportError = ::openpower::dump::TransportError;
+
 namespace internal
 {
 /**
  * @brief Reads the MCTP endpoint ID out of a file
+ * @throws TransportError if the endpoint ID could not be read
  */
 mctp_eid_t readEID();
 } // namespace internal
 /**
  * @brief Send new file available PLDM command
  *
+ * @throws TransportError if the request could not be sent to the host
+ *
  * @param[in] id - Dump id
  * @param[in] dumpType - Type of the dump.
  * @param[in] dumpSize - size of the dump
@@ -0,0 +1,12 @@
+#include "pldm_transport.hpp"
+
+#include "send_pldm_cmd.hpp"
+
+namespace openpower::dump::pldm
+{
+
+void PldmTransport::announce(const DumpKey& key, uint64_t size)
+{
+    sendNewDumpCmd(key.id, key.type, size);
+}
+} // namespace openpower::dump::pldm
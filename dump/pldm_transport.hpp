@@ -0,0 +1,31 @@
+#pragma once
+
+#include "transport.hpp"
+
+namespace openpower::dump::pldm
+{
+
+/**
+ * @class PldmTransport
+ * @brief Announce the dumps with the PLDM new file available request sent
+ *        through pldmd
+ */
+class PldmTransport : public Transport
+{
+  public:
+    PldmTransport() = default;
+    PldmTransport(const PldmTransport&) = delete;
+    PldmTransport& operator=(const PldmTransport&) = delete;
+    PldmTransport(PldmTransport&&) = delete;
+    PldmTransport& operator=(PldmTransport&&) = delete;
+    virtual ~PldmTransport() = default;
+
+    /**
+     * @brief Send the new dump offload command to PLDM
+     * @throws TransportError if the request could not be sent to the host
+     * @param[in] key - key of the dump
+     * @param[in] size - size of the dump announced
+     */
+    void announce(const DumpKey& key, uint64_t size) override;
+};
+} // namespace openpower::dump::pldm
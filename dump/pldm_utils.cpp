@@ -1,17 +1,20 @@
 // SPDX-License-Identifier: Apache-2.0
 
-#include "xyz/openbmc_project/Common/error.hpp"
+#include "logging.hpp"
+#include "transport.hpp"
 
 #include <fmt/core.h>
 #include <libpldm/base.h>
 #include <libpldm/pldm.h>
 
-#include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
 
 namespace openpower::dump::pldm
 {
 using namespace phosphor::logging;
+using ::openpower::dump::logging::logMsg;
 namespace internal
 {
 std::string getService(sdbusplus::bus::bus& bus, const std::string& path,
@@ -35,38 +38,31 @@ std::string getService(sdbusplus::bus::bus& bus, const std::string& path,
         reply.read(response);
         if (response.empty())
         {
-            log<level::ERR>(fmt::format("Error in mapper response for getting "
-                                        "service name, PATH({}), INTERFACE({})",
-                                        path, interface)
-                                .c_str());
+            logMsg<level::ERR>("Error in mapper response for getting "
+                               "service name, PATH({}), INTERFACE({})",
+                               path, interface);
             return std::string{};
         }
     }
     catch (const sdbusplus::exception::exception& e)
     {
-        log<level::ERR>(fmt::format("Error in mapper method call, "
-                                    "errormsg({}), PATH({}), INTERFACE({})",
-                                    e.what(), path, interface)
-                            .c_str());
+        logMsg<level::ERR>("Error in mapper method call, "
+                           "errormsg({}), PATH({}), INTERFACE({})",
+                           e.what(), path, interface);
         return std::string{};
     }
     return response[0].first;
 }
 } // namespace internal
 
-using NotAllowed = sdbusplus::xyz::openbmc_project::Common::Error::NotAllowed;
-using Reason = xyz::openbmc_project::Common::NotAllowed::REASON;
-
 int openPLDM()
 {
     auto fd = pldm_open();
     if (fd < 0)
     {
         auto e = errno;
-        log<level::ERR>(
-            fmt::format("pldm_open failed, errno({}), FD({})", e, fd).c_str());
-        elog<NotAllowed>(Reason("Required host dump action via pldm is not "
-                                "allowed due to pldm_open failed"));
+        logMsg<level::ERR>("pldm_open failed, errno({}), FD({})", e, fd);
+        throw TransportError(fmt::format("pldm_open failed errno({})", e));
     }
     return fd;
 }
@@ -78,14 +74,26 @@ uint8_t getPLDMInstanceID(uint8_t eid)
 
     auto bus = sdbusplus::bus::new_default();
     auto service = internal::getService(bus, pldm, pldmRequester);
-
-    auto method = bus.new_method_call(service.c_str(), pldm, pldmRequester,
-                                      "GetInstanceId");
-    method.append(eid);
-    auto reply = bus.call(method);
+    if (service.empty())
+    {
+        throw TransportError("pldmd requester service not found");
+    }
 
     uint8_t instanceID = 0;
-    reply.read(instanceID);
+    try
+    {
+        auto method = bus.new_method_call(service.c_str(), pldm,
+                                          pldmRequester, "GetInstanceId");
+        method.append(eid);
+        auto reply = bus.call(method);
+        reply.read(instanceID);
+    }
+    catch (const sdbusplus::exception::exception& e)
+    {
+        logMsg<level::ERR>("GetInstanceId failed, errormsg({})", e.what());
+        throw TransportError(
+            fmt::format("GetInstanceId failed errormsg({})", e.what()));
+    }
 
     return instanceID;
 }
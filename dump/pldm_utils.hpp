@@ -51,8 +51,7 @@ struct CustomFd
  * @brief Opens the PLDM file descriptor
  *
  * @return file descriptor on success and throw
- *         exception (xyz::openbmc_project::Common::Error::NotAllowed) on
- *         failures.
+ *         exception (TransportError) on failures.
  */
 int openPLDM();
 
@@ -61,6 +60,8 @@ int openPLDM();
  *
  * @param[in] eid - The PLDM EID
  *
+ * @throws TransportError if the instance ID could not be read from pldmd
+ *
  * @return uint8_t - The instance ID
  **/
 uint8_t getPLDMInstanceID(uint8_t eid);
@@ -0,0 +1,169 @@
+#include "config.h"
+
+#include "prefetch_stage.hpp"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+PrefetchStage::PrefetchStage(WorkerPool& workerPool) :
+    _workerPool(workerPool), _readRate(prefetchReadRate)
+{}
+
+void PrefetchStage::start(const DumpKey& key, uint64_t size)
+{
+    if (_dump)
+    {
+        stop();
+    }
+    _dump = key;
+    _startTime = std::chrono::steady_clock::now();
+    _fileSize = size;
+    _prefetchEnd = prefetchWindowSize;
+    advise(key, 0, prefetchWindowSize, 0);
+}
+
+void PrefetchStage::lineUp(const DumpKey& key)
+{
+    if (_dump == key)
+    {
+        return;
+    }
+    advise(key, 0, prefetchWindowSize, 0);
+}
+
+void PrefetchStage::advance()
+{
+    if (!_dump)
+    {
+        return;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - _startTime);
+    uint64_t readPos =
+        static_cast<uint64_t>(elapsed.count()) * _readRate / 1000;
+    if (_fileSize != 0 && _prefetchEnd >= _fileSize)
+    {
+        // whole file is read ahead
+        return;
+    }
+    if (readPos + prefetchWindowSize <= _prefetchEnd)
+    {
+        // host is still within the window read ahead
+        return;
+    }
+    // read rate may have been raised or a tick missed, catch up to a window
+    // past the read position in one advice
+    uint64_t offset = _prefetchEnd;
+    while (_prefetchEnd < readPos + prefetchWindowSize)
+    {
+        _prefetchEnd += prefetchWindowSize;
+    }
+    if (_fileSize != 0)
+    {
+        _prefetchEnd = std::min(_prefetchEnd, _fileSize);
+    }
+    // read position is an estimate, keep two windows behind it in case host
+    // is slower
+    uint64_t dropEnd = readPos > 2 * prefetchWindowSize
+                           ? readPos - 2 * prefetchWindowSize
+                           : 0;
+    advise(*_dump, offset, _prefetchEnd, dropEnd);
+}
+
+void PrefetchStage::stop()
+{
+    if (!_dump)
+    {
+        return;
+    }
+    DumpKey key = *_dump;
+    _dump.reset();
+    _workerPool.post(
+        [key]() {
+            auto path = getDumpFilePath(key);
+            if (!path)
+            {
+                return;
+            }
+            int fd = open(path->c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return;
+            }
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        },
+        nullptr);
+}
+
+void PrefetchStage::advise(const DumpKey& key, uint64_t offset,
+                           uint64_t end, uint64_t dropEnd)
+{
+    _workerPool.post(
+        [key, offset, end, dropEnd]() {
+            auto path = getDumpFilePath(key);
+            if (!path)
+            {
+                return;
+            }
+            int fd = open(path->c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return;
+            }
+            struct stat st = {};
+            if (fstat(fd, &st) == 0)
+            {
+                uint64_t size = st.st_size;
+                if (dropEnd > 0)
+                {
+                    posix_fadvise(fd, 0, std::min(dropEnd, size),
+                                  POSIX_FADV_DONTNEED);
+                }
+                if (offset < size && !isMemoryLow())
+                {
+                    posix_fadvise(fd, offset, std::min(end, size) - offset,
+                                  POSIX_FADV_WILLNEED);
+                }
+            }
+            close(fd);
+        },
+        nullptr);
+}
+
+bool PrefetchStage::isMemoryLow()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string name;
+    uint64_t valueKiB = 0;
+    std::string unit;
+    while (meminfo >> name >> valueKiB >> unit)
+    {
+        if (name == "MemAvailable:")
+        {
+            bool isLow = valueKiB * 1024 < prefetchMinAvailableMemory;
+            if (isLow)
+            {
+                logMsg<level::DEBUG>("Prefetch skipped available memory "
+                                     "({}) KiB",
+                                     valueKiB);
+            }
+            return isLow;
+        }
+    }
+    // not known, do not add to the memory pressure
+    return true;
+}
+} // namespace openpower::dump
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "dump_key.hpp"
+#include "worker_pool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace openpower::dump
+{
+
+/**
+ * @class PrefetchStage
+ * @brief Keep the dump being read by the host in the page cache
+ * @details Host reads the announced dump file sequentially through PLDM,
+ *  the file is read into the page cache ahead of the expected host read
+ *  position in bounded windows and the pages behind it are dropped. The
+ *  first window of the next dump in the queue is read as well. The file
+ *  advice is given on the worker thread, prefetch is skipped when the
+ *  available memory is low.
+ */
+class PrefetchStage
+{
+  public:
+    PrefetchStage() = delete;
+    PrefetchStage(const PrefetchStage&) = delete;
+    PrefetchStage& operator=(const PrefetchStage&) = delete;
+    PrefetchStage(PrefetchStage&&) = delete;
+    PrefetchStage& operator=(PrefetchStage&&) = delete;
+    virtual ~PrefetchStage() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] workerPool - worker pool to give the file advice on
+     */
+    explicit PrefetchStage(WorkerPool& workerPool);
+
+    /**
+     * @brief Dump is announced to the host, start prefetching it
+     * @param[in] key - key of the dump announced
+     * @param[in] size - size of the file read by the host, 0 if not known
+     */
+    void start(const DumpKey& key, uint64_t size);
+
+    /**
+     * @brief Prefetch the first window of the next dump to offload
+     * @param[in] key - key of the next dump
+     */
+    void lineUp(const DumpKey& key);
+
+    /**
+     * @brief Move the prefetch window along the expected host read position,
+     *        the range read ahead is caught up to a window past it
+     */
+    void advance();
+
+    /**
+     * @brief Offload of the dump is done, drop its pages from the cache
+     */
+    void stop();
+
+    /**
+     * @brief Set the expected rate of the host reading the dump
+     * @param[in] rate - bytes per second
+     */
+    void setReadRate(uint64_t rate)
+    {
+        _readRate = rate;
+    }
+
+  private:
+    /**
+     * @brief Give the file advice on the worker thread
+     * @param[in] key - key of the dump
+     * @param[in] offset - start of the range to read ahead
+     * @param[in] end - end of the range to read ahead
+     * @param[in] dropEnd - pages before this offset are dropped, 0 for none
+     */
+    void advise(const DumpKey& key, uint64_t offset, uint64_t end,
+                uint64_t dropEnd);
+
+    /**
+     * @brief Check the available memory against the prefetch threshold
+     * @return true if prefetch should be skipped
+     */
+    static bool isMemoryLow();
+
+    /** @brief worker pool to give the advice on */
+    WorkerPool& _workerPool;
+
+    /** @brief dump being read by the host */
+    std::optional<DumpKey> _dump;
+
+    /** @brief time at which the dump was announced */
+    std::chrono::steady_clock::time_point _startTime;
+
+    /** @brief expected rate of the host reading the dump, bytes/second */
+    uint64_t _readRate;
+
+    /** @brief end of the range read ahead */
+    uint64_t _prefetchEnd = 0;
+
+    /** @brief size of the file read by the host, 0 if not known */
+    uint64_t _fileSize = 0;
+};
+} // namespace openpower::dump
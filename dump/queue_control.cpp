@@ -0,0 +1,359 @@
+#include "config.h"
+
+#include "queue_control.hpp"
+
+#include "logging.hpp"
+
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::getDumpTypeName;
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+namespace
+{
+constexpr std::array<DumpType, 4> dumpTypes = {
+    DumpType::bmc, DumpType::hardware, DumpType::hostboot, DumpType::sbe};
+
+/**
+ * @brief Get the key of the dump from the entry object path
+ * @param[in] path - D-Bus path of the dump entry object
+ * @return key of the dump, nullopt if not a dump entry path
+ */
+std::optional<DumpKey> toDumpKey(const object_path& path)
+{
+    for (auto type : dumpTypes)
+    {
+        const std::string& prefix = getEntryObjPath(type);
+        if (path.str.compare(0, prefix.size(), prefix) == 0)
+        {
+            return getDumpKey(type, path);
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Get the name of the offload status
+ * @param[in] status - offload status
+ * @return name of the status
+ */
+const char* getStatusName(HostOffloaderQueue::OffloadStatus status)
+{
+    switch (status)
+    {
+        case HostOffloaderQueue::OffloadStatus::queued:
+            return "Queued";
+        case HostOffloaderQueue::OffloadStatus::announced:
+            return "Announced";
+        case HostOffloaderQueue::OffloadStatus::completed:
+            return "Completed";
+        case HostOffloaderQueue::OffloadStatus::failed:
+            return "Failed";
+        case HostOffloaderQueue::OffloadStatus::removed:
+            return "Removed";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Get the dump type from the name
+ * @param[in] name - name of the dump type
+ * @return dump type, nullopt if not a dump type name
+ */
+std::optional<DumpType> toDumpType(const std::string& name)
+{
+    for (auto type : dumpTypes)
+    {
+        if (name == getDumpTypeName(type))
+        {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace
+
+// clang-format off
+const sd_bus_vtable QueueControl::_vtable[] = {
+    SD_BUS_VTABLE_START(0),
+    SD_BUS_METHOD("List", "", "a(otttbitt)", QueueControl::list,
+                  SD_BUS_VTABLE_UNPRIVILEGED),
+    SD_BUS_METHOD("Promote", "o", "", QueueControl::promote, 0),
+    SD_BUS_METHOD("Demote", "o", "", QueueControl::demote, 0),
+    SD_BUS_METHOD("Cancel", "o", "", QueueControl::cancel, 0),
+    SD_BUS_METHOD("Pause", "s", "", QueueControl::pause, 0),
+    SD_BUS_METHOD("Resume", "s", "", QueueControl::resume, 0),
+    SD_BUS_PROPERTY("PausedTypes", "as", QueueControl::getPausedTypes, 0,
+                    SD_BUS_VTABLE_PROPERTY_EMITS_CHANGE),
+    SD_BUS_PROPERTY("Status", "a{os}", QueueControl::getStatus, 0,
+                    SD_BUS_VTABLE_PROPERTY_EMITS_INVALIDATION),
+    SD_BUS_PROPERTY("Throughput", "t", QueueControl::getThroughput, 0,
+                    SD_BUS_VTABLE_PROPERTY_EMITS_CHANGE),
+    SD_BUS_SIGNAL("StatusChanged", "os", 0),
+    SD_BUS_VTABLE_END};
+// clang-format on
+
+QueueControl::QueueControl(sdbusplus::bus::bus& bus,
+                           sdeventplus::Event& event,
+                           HostOffloaderQueue& dumpQueue) :
+    _dumpQueue(dumpQueue),
+    _intf(bus, offloadObjPath, queueControlIntf, _vtable, this),
+    _throughput(dumpQueue.getThroughput()),
+    _statusEvent(event, [this](sdeventplus::source::EventBase&) {
+        _intf.property_changed("Status");
+        if (_throughput != _dumpQueue.getThroughput())
+        {
+            // throughput is estimated on offload completion
+            _throughput = _dumpQueue.getThroughput();
+            _intf.property_changed("Throughput");
+        }
+    })
+{
+    _statusEvent.set_priority(SD_EVENT_PRIORITY_IDLE);
+    _statusEvent.set_enabled(sdeventplus::source::Enabled::Off);
+}
+
+void QueueControl::statusChanged(const DumpKey& key,
+                                 HostOffloaderQueue::OffloadStatus status)
+{
+    using OffloadStatus = HostOffloaderQueue::OffloadStatus;
+    if (status != OffloadStatus::queued && status != OffloadStatus::announced)
+    {
+        // queued dumps are read from the queue, keep only the recent ones
+        // which left the queue
+        if (_recentStatus.size() >= recentStatusCount)
+        {
+            _recentStatus.erase(_recentStatus.begin());
+        }
+        _recentStatus.emplace_back(key, status);
+    }
+    try
+    {
+        auto signal = _intf.new_signal("StatusChanged");
+        signal.append(getDumpObjPath(key), std::string(getStatusName(status)));
+        signal.signal_send();
+    }
+    catch (const std::exception& ex)
+    {
+        logMsg<level::ERR>("Control failed to signal dump id ({}) type ({}) "
+                           "status ({})",
+                           key.id, key.type, ex.what());
+    }
+    _statusEvent.set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+
+int QueueControl::list(sd_bus_message* msg, void* context,
+                       sd_bus_error* error)
+{
+    auto* self = static_cast<QueueControl*>(context);
+    try
+    {
+        std::vector<std::tuple<object_path, uint64_t, uint64_t, uint64_t,
+                               bool, int32_t, uint64_t, uint64_t>>
+            entries;
+        for (const auto& dump : self->_dumpQueue.getStatus())
+        {
+            entries.emplace_back(
+                getDumpObjPath(dump.key), dump.size, dump.digest,
+                static_cast<uint64_t>(dump.waitTime.count()), dump.inFlight,
+                dump.priority, static_cast<uint64_t>(dump.startEta.count()),
+                static_cast<uint64_t>(dump.completionEta.count()));
+        }
+        sdbusplus::message::message call(msg);
+        auto reply = call.new_method_return();
+        reply.append(entries);
+        reply.method_return();
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+
+int QueueControl::promote(sd_bus_message* msg, void* context,
+                          sd_bus_error* error)
+{
+    return static_cast<QueueControl*>(context)->dumpOperation(
+        msg, error, &HostOffloaderQueue::promote);
+}
+
+int QueueControl::demote(sd_bus_message* msg, void* context,
+                         sd_bus_error* error)
+{
+    return static_cast<QueueControl*>(context)->dumpOperation(
+        msg, error, &HostOffloaderQueue::demote);
+}
+
+int QueueControl::cancel(sd_bus_message* msg, void* context,
+                         sd_bus_error* error)
+{
+    // host is reading the dump being offloaded, cancelling it would let
+    // the next dump be announced while the host still reads this one
+    return static_cast<QueueControl*>(context)->dumpOperation(
+        msg, error, &HostOffloaderQueue::cancel, false);
+}
+
+int QueueControl::pause(sd_bus_message* msg, void* context,
+                        sd_bus_error* error)
+{
+    return static_cast<QueueControl*>(context)->setPaused(msg, error, true);
+}
+
+int QueueControl::resume(sd_bus_message* msg, void* context,
+                         sd_bus_error* error)
+{
+    return static_cast<QueueControl*>(context)->setPaused(msg, error, false);
+}
+
+int QueueControl::getStatus(sd_bus* /*bus*/, const char* /*path*/,
+                            const char* /*intf*/, const char* /*property*/,
+                            sd_bus_message* reply, void* context,
+                            sd_bus_error* error)
+{
+    using OffloadStatus = HostOffloaderQueue::OffloadStatus;
+    auto* self = static_cast<QueueControl*>(context);
+    try
+    {
+        std::map<object_path, std::string> status;
+        for (const auto& [key, recent] : self->_recentStatus)
+        {
+            status[getDumpObjPath(key)] = getStatusName(recent);
+        }
+        for (const auto& dump : self->_dumpQueue.getStatus())
+        {
+            status[getDumpObjPath(dump.key)] = getStatusName(
+                dump.inFlight ? OffloadStatus::announced
+                              : OffloadStatus::queued);
+        }
+        sdbusplus::message::message msg(reply);
+        msg.append(status);
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+
+int QueueControl::getThroughput(sd_bus* /*bus*/, const char* /*path*/,
+                                const char* /*intf*/,
+                                const char* /*property*/,
+                                sd_bus_message* reply, void* context,
+                                sd_bus_error* error)
+{
+    auto* self = static_cast<QueueControl*>(context);
+    try
+    {
+        sdbusplus::message::message msg(reply);
+        msg.append(self->_dumpQueue.getThroughput());
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+
+int QueueControl::getPausedTypes(sd_bus* /*bus*/, const char* /*path*/,
+                                 const char* /*intf*/,
+                                 const char* /*property*/,
+                                 sd_bus_message* reply, void* context,
+                                 sd_bus_error* error)
+{
+    auto* self = static_cast<QueueControl*>(context);
+    try
+    {
+        std::vector<std::string> paused;
+        for (auto type : dumpTypes)
+        {
+            if (self->_dumpQueue.isPaused(type))
+            {
+                paused.emplace_back(getDumpTypeName(type));
+            }
+        }
+        sdbusplus::message::message msg(reply);
+        msg.append(paused);
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+
+int QueueControl::dumpOperation(
+    sd_bus_message* msg, sd_bus_error* error,
+    bool (HostOffloaderQueue::*operation)(const DumpKey&),
+    bool inFlightAllowed)
+{
+    try
+    {
+        sdbusplus::message::message call(msg);
+        object_path path;
+        call.read(path);
+        auto key = toDumpKey(path);
+        if (!key)
+        {
+            return sd_bus_error_set(error, SD_BUS_ERROR_INVALID_ARGS,
+                                    "Not a dump entry path");
+        }
+        logMsg<level::INFO>("Control ({}) dump id ({}) type ({})",
+                            call.get_member(), key->id, key->type);
+        if (!inFlightAllowed && _dumpQueue.isInFlight(*key))
+        {
+            return sd_bus_error_set(error, SD_BUS_ERROR_NOT_SUPPORTED,
+                                    "Dump is being offloaded to the host");
+        }
+        if (!(_dumpQueue.*operation)(*key))
+        {
+            return sd_bus_error_set(error, SD_BUS_ERROR_INVALID_ARGS,
+                                    "Dump is not queued for offload");
+        }
+        auto reply = call.new_method_return();
+        reply.method_return();
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+
+int QueueControl::setPaused(sd_bus_message* msg, sd_bus_error* error,
+                            bool paused)
+{
+    try
+    {
+        sdbusplus::message::message call(msg);
+        std::string name;
+        call.read(name);
+        auto type = toDumpType(name);
+        if (!type)
+        {
+            return sd_bus_error_set(error, SD_BUS_ERROR_INVALID_ARGS,
+                                    "Unsupported dump type");
+        }
+        if (_dumpQueue.isPaused(*type) != paused)
+        {
+            _dumpQueue.setPaused(*type, paused);
+            _intf.property_changed("PausedTypes");
+        }
+        auto reply = call.new_method_return();
+        reply.method_return();
+    }
+    catch (const std::exception& ex)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, ex.what());
+    }
+    return 1;
+}
+} // namespace openpower::dump
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "host_offloader_queue.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+namespace openpower::dump
+{
+/**
+ * @class QueueControl
+ * @brief D-Bus control object of the dump offload queue
+ * @details Lists the queued and in flight dumps, dumps can be promoted,
+ *          demoted or cancelled and offload of a dump type can be paused
+ *          and resumed. Changes take effect on the next scheduling pass of
+ *          the queue. Offload status changes of the dumps are signalled so
+ *          that clients need not poll the dump entries.
+ */
+class QueueControl
+{
+  public:
+    QueueControl() = delete;
+    QueueControl(const QueueControl&) = delete;
+    QueueControl& operator=(const QueueControl&) = delete;
+    QueueControl(QueueControl&&) = delete;
+    QueueControl& operator=(QueueControl&&) = delete;
+    virtual ~QueueControl() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] bus - D-Bus to attach to
+     * @param[in] event - event handler
+     * @param[in] dumpQueue - queue to control
+     */
+    QueueControl(sdbusplus::bus::bus& bus, sdeventplus::Event& event,
+                 HostOffloaderQueue& dumpQueue);
+
+    /**
+     * @brief Offload status of a dump is changed, StatusChanged signal is
+     *        emitted and the Status property is invalidated
+     * @param[in] key - key of the dump
+     * @param[in] status - new offload status of the dump
+     */
+    void statusChanged(const DumpKey& key,
+                       HostOffloaderQueue::OffloadStatus status);
+
+  private:
+    /**
+     * @brief List method, queued dumps in offload order with the predicted
+     *        time to start and to complete the offload
+     * @param[in] msg - method call message
+     * @param[in] context - control object
+     * @param[out] error - error of the method call
+     * @return positive on success, negative errno on error
+     */
+    static int list(sd_bus_message* msg, void* context, sd_bus_error* error);
+
+    /** @brief Promote method, dump entry path as argument */
+    static int promote(sd_bus_message* msg, void* context,
+                       sd_bus_error* error);
+
+    /** @brief Demote method, dump entry path as argument */
+    static int demote(sd_bus_message* msg, void* context,
+                      sd_bus_error* error);
+
+    /** @brief Cancel method, dump entry path as argument */
+    static int cancel(sd_bus_message* msg, void* context,
+                      sd_bus_error* error);
+
+    /** @brief Pause method, dump type name as argument */
+    static int pause(sd_bus_message* msg, void* context, sd_bus_error* error);
+
+    /** @brief Resume method, dump type name as argument */
+    static int resume(sd_bus_message* msg, void* context,
+                      sd_bus_error* error);
+
+    /** @brief Getter of the Status property */
+    static int getStatus(sd_bus* bus, const char* path, const char* intf,
+                         const char* property, sd_bus_message* reply,
+                         void* context, sd_bus_error* error);
+
+    /** @brief Getter of the Throughput property, bytes per second */
+    static int getThroughput(sd_bus* bus, const char* path, const char* intf,
+                             const char* property, sd_bus_message* reply,
+                             void* context, sd_bus_error* error);
+
+    /** @brief Getter of the PausedTypes property */
+    static int getPausedTypes(sd_bus* bus, const char* path,
+                              const char* intf, const char* property,
+                              sd_bus_message* reply, void* context,
+                              sd_bus_error* error);
+
+    /**
+     * @brief Apply a queue operation to the dump in the method call
+     * @param[in] msg - method call message with the dump entry path
+     * @param[in] error - error of the method call
+     * @param[in] operation - queue operation, false if dump is not queued
+     * @param[in] inFlightAllowed - false to reject the operation on the dump
+     *                              being offloaded
+     * @return positive on success, negative errno on error
+     */
+    int dumpOperation(sd_bus_message* msg, sd_bus_error* error,
+                      bool (HostOffloaderQueue::*operation)(const DumpKey&),
+                      bool inFlightAllowed = true);
+
+    /**
+     * @brief Pause or resume the dump type in the method call
+     * @param[in] msg - method call message with the dump type name
+     * @param[in] error - error of the method call
+     * @param[in] paused - true to pause, false to resume
+     * @return positive on success, negative errno on error
+     */
+    int setPaused(sd_bus_message* msg, sd_bus_error* error, bool paused);
+
+    /** @brief D-Bus methods and properties of the control interface */
+    static const sd_bus_vtable _vtable[];
+
+    /** @brief Queue to control */
+    HostOffloaderQueue& _dumpQueue;
+
+    /** @brief control interface on the bus */
+    sdbusplus::server::interface_t _intf;
+
+    /** @brief throughput last reported on the bus */
+    uint64_t _throughput;
+
+    /** @brief dumps which left the queue with their final status, oldest
+     *  first */
+    std::vector<std::pair<DumpKey, HostOffloaderQueue::OffloadStatus>>
+        _recentStatus;
+
+    /**
+     * @brief idle priority event to invalidate the Status property, a burst
+     *  of status changes results in a single invalidation
+     */
+    sdeventplus::source::Defer _statusEvent;
+};
+} // namespace openpower::dump
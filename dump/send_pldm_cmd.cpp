@@ -1,16 +1,15 @@
 #include "send_pldm_cmd.hpp"
 
+#include "logging.hpp"
 #include "pldm_oem_cmds.hpp"
 
 #include <fmt/format.h>
 #include <libpldm/file_io.h>
 
-#include <phosphor-logging/log.hpp>
-
 namespace openpower::dump::pldm
 {
+using ::openpower::dump::logging::logMsg;
 using ::phosphor::logging::level;
-using ::phosphor::logging::log;
 
 void sendNewDumpCmd(uint32_t dumpId, DumpType dumpType, uint64_t dumpSize)
 {
@@ -31,17 +30,15 @@ void sendNewDumpCmd(uint32_t dumpId, DumpType dumpType, uint64_t dumpSize)
             pldmDumpType = 0x12; // PLDM_FILE_TYPE_HARDWARE_DUMP
             break;
         default:
-            std::string err =
-                fmt::format("Unsupported dump type ({}) ", dumpType);
-            log<level::ERR>(err.c_str());
-            throw std::out_of_range(err);
+            logMsg<level::ERR>("Unsupported dump type ({})", dumpType);
+            throw std::out_of_range(
+                fmt::format("Unsupported dump type ({}) ", dumpType));
             break;
     }
 
-    log<level::INFO>(fmt::format("sendNewDumpCmd Id({}) Size({}) Type({}) "
-                                 "PldmDumpType({})",
-                                 dumpId, dumpSize, dumpType, pldmDumpType)
-                         .c_str());
+    logMsg<level::INFO>("sendNewDumpCmd Id({}) Size({}) Type({}) "
+                        "PldmDumpType({})",
+                        dumpId, dumpSize, dumpType, pldmDumpType);
     openpower::dump::pldm::newFileAvailable(
         dumpId, static_cast<pldm_fileio_file_type>(pldmDumpType), dumpSize);
 }
@@ -0,0 +1,307 @@
+#include "config.h"
+
+#include "signal_thread.hpp"
+
+#include "dbus_util.hpp"
+#include "dump_key.hpp"
+#include "logging.hpp"
+
+namespace openpower::dump
+{
+using ::openpower::dump::utility::DBusInteracesList;
+using ::openpower::dump::utility::DBusInteracesMap;
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+namespace
+{
+/**
+ * @brief Build the record of a decoded dump signal
+ * @param[in] signal - signal decoded
+ * @param[in] key - key of the dump
+ * @param[in] flag - state carried by the signal
+ * @param[in] value - value carried by the signal
+ * @return record of the signal
+ */
+trace::Record makeRecord(trace::Signal signal, const DumpKey& key,
+                         bool flag = false, uint64_t value = 0)
+{
+    return trace::Record{0,
+                         signal,
+                         static_cast<uint8_t>(key.type),
+                         flag,
+                         0,
+                         key.id,
+                         value};
+}
+} // namespace
+
+SignalThread::SignalThread(sdeventplus::Event& event, Dispatch dispatch) :
+    _dispatch(std::move(dispatch)),
+    _entryPaths({DumpType::bmc, DumpType::hostboot, DumpType::sbe,
+                 DumpType::hardware}),
+    _channel(event)
+{}
+
+SignalThread::~SignalThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopChannel != nullptr)
+        {
+            auto threadEvent = _threadEvent;
+            _stopChannel->post([threadEvent]() { threadEvent->exit(0); });
+        }
+    }
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void SignalThread::start()
+{
+    std::promise<void> ready;
+    auto started = ready.get_future();
+    _thread = std::thread([this, &ready]() { run(ready); });
+    // rethrows if the thread failed to add the matches
+    started.get();
+}
+
+SignalThread::Counters SignalThread::getCounters() const
+{
+    return Counters{_received.load(std::memory_order_relaxed),
+                    _decodesAvoided.load(std::memory_order_relaxed),
+                    _wakeupsAvoided.load(std::memory_order_relaxed)};
+}
+
+void SignalThread::run(std::promise<void>& ready)
+{
+    bool isReady = false;
+    try
+    {
+        auto event = sdeventplus::Event::get_new();
+        auto bus = sdbusplus::bus::new_system();
+        EventChannel stopChannel(event);
+        Matches matches;
+        addMatches(bus, matches);
+        bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopChannel = &stopChannel;
+            _threadEvent = &event;
+        }
+        isReady = true;
+        ready.set_value();
+
+        event.loop();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopChannel = nullptr;
+            _threadEvent = nullptr;
+        }
+        matches.clear();
+        bus.detach_event();
+        auto counters = getCounters();
+        logMsg<level::INFO>("Signal thread property signals ({}) not decoded "
+                            "({}) not dispatched ({})",
+                            counters.received, counters.decodesAvoided,
+                            counters.wakeupsAvoided);
+    }
+    catch (const std::exception& ex)
+    {
+        logMsg<level::ERR>("Signal thread failed ({})", ex.what());
+        if (!isReady)
+        {
+            ready.set_exception(std::current_exception());
+        }
+    }
+}
+
+void SignalThread::addMatches(sdbusplus::bus::bus& bus, Matches& matches)
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    // object path argument is matched in the dump namespace, argNpath takes
+    // the trailing '/' to match the paths under it
+    const std::string dumpNamespace = std::string(dumpObjPath) + "/";
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        interfacesAdded() + sender(dumpService) + argNpath(0, dumpNamespace),
+        [this](auto& msg) { this->interfaceAdded(msg); }));
+
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        interfacesRemoved() + sender(dumpService) + argNpath(0, dumpNamespace),
+        [this](auto& msg) { this->interfaceRemoved(msg); }));
+
+    // properties dictionary can not be matched by the broker, only the
+    // interface name, the Status property is picked out on the thread
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        type::signal() + member("PropertiesChanged") +
+            sender(dumpService) + path_namespace(dumpObjPath) +
+            interface(dbusPropIntf) + argN(0, progressIntf),
+        [this](auto& msg) { this->progressChanged(msg); }));
+
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        type::signal() + member("PropertiesChanged") +
+            sender(dumpService) + path_namespace(dumpObjPath) +
+            interface(dbusPropIntf) + argN(0, entryIntf),
+        [this](auto& msg) { this->entryChanged(msg); }));
+}
+
+std::optional<DumpKey> SignalThread::toDumpKey(const object_path& path) const
+{
+    auto type = _entryPaths.find(path.str);
+    if (!type)
+    {
+        return std::nullopt;
+    }
+    return getDumpKey(*type, path);
+}
+
+void SignalThread::interfaceAdded(sdbusplus::message::message& msg)
+{
+    try
+    {
+        sdbusplus::message::object_path objPath;
+        DBusInteracesMap interfaces;
+        msg.read(objPath, interfaces);
+        auto key = toDumpKey(objPath);
+        if (!key)
+        {
+            return;
+        }
+        logMsg<level::INFO>("Watch interfaceAdded path ({})", objPath.str);
+        // check if dump generation is already completed
+        bool isComplete = false;
+        auto iface = interfaces.find(progressIntf);
+        if (iface != interfaces.end())
+        {
+            isComplete = isDumpProgressCompleted(iface->second);
+        }
+        // size is used to prioritise the dumps when storage is low
+        uint64_t size = 0;
+        auto entry = interfaces.find(entryIntf);
+        if (entry != interfaces.end())
+        {
+            size = getDumpSize(entry->second);
+        }
+        post(makeRecord(trace::Signal::dumpAdded, *key, isComplete, size));
+    }
+    catch (const std::exception& ex)
+    {
+        logMsg<level::ERR>("Watch exception in interfaceAdded ({})",
+                           ex.what());
+    }
+}
+
+void SignalThread::interfaceRemoved(sdbusplus::message::message& msg)
+{
+    try
+    {
+        sdbusplus::message::object_path objPath;
+        DBusInteracesList interfaces;
+        msg.read(objPath, interfaces);
+        auto key = toDumpKey(objPath);
+        if (!key)
+        {
+            return;
+        }
+        logMsg<level::INFO>("Watch interfaceRemoved path ({})", objPath.str);
+        post(makeRecord(trace::Signal::dumpRemoved, *key));
+    }
+    catch (const std::exception& ex)
+    {
+        logMsg<level::ERR>("Watch exception in interfaceRemoved ({})",
+                           ex.what());
+    }
+}
+
+void SignalThread::progressChanged(sdbusplus::message::message& msg)
+{
+    ++_received;
+    try
+    {
+        object_path objPath = msg.get_path();
+        auto key = toDumpKey(objPath);
+        if (!key)
+        {
+            ++_decodesAvoided;
+            ++_wakeupsAvoided;
+            return;
+        }
+        // percentage updates while the dump is generated carry no Status
+        auto status = readChangedProperty(msg, "Status");
+        if (!status)
+        {
+            ++_decodesAvoided;
+            ++_wakeupsAvoided;
+            return;
+        }
+        if (!isDumpProgressCompleted(*status))
+        {
+            logMsg<level::DEBUG>("Watch propertiesChanged object path ({}) "
+                                 "status is not completed",
+                                 objPath.str);
+            ++_wakeupsAvoided;
+            return;
+        }
+        logMsg<level::INFO>("Watch propertiesChanged object path ({})",
+                            objPath.str);
+        post(makeRecord(trace::Signal::dumpCompleted, *key));
+    }
+    catch (const std::exception& ex)
+    {
+        ++_wakeupsAvoided;
+        logMsg<level::ERR>("Watch exception in propertiesChanged ({})",
+                           ex.what());
+    }
+}
+
+void SignalThread::entryChanged(sdbusplus::message::message& msg)
+{
+    ++_received;
+    try
+    {
+        object_path objPath = msg.get_path();
+        auto key = toDumpKey(objPath);
+        if (!key)
+        {
+            ++_decodesAvoided;
+            ++_wakeupsAvoided;
+            return;
+        }
+        auto offloaded = readChangedProperty(msg, "Offloaded");
+        if (!offloaded)
+        {
+            ++_decodesAvoided;
+            ++_wakeupsAvoided;
+            return;
+        }
+        if (!isDumpOffloaded(*offloaded))
+        {
+            ++_wakeupsAvoided;
+            return;
+        }
+        logMsg<level::INFO>("Watch dump offloaded path ({})", objPath.str);
+        post(makeRecord(trace::Signal::dumpOffloaded, *key));
+    }
+    catch (const std::exception& ex)
+    {
+        ++_wakeupsAvoided;
+        logMsg<level::ERR>("Watch exception in entryPropertiesChanged ({})",
+                           ex.what());
+    }
+}
+
+void SignalThread::post(const trace::Record& rec)
+{
+    trace::record(rec.signal, static_cast<DumpType>(rec.type), rec.id,
+                  rec.flag, rec.value);
+    _channel.post([this, rec]() { _dispatch(rec); });
+}
+} // namespace openpower::dump
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "dump_key.hpp"
+#include "event_channel.hpp"
+#include "path_trie.hpp"
+#include "signal_trace.hpp"
+#include "utility.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/event.hpp>
+#include <thread>
+#include <vector>
+
+namespace openpower::dump
+{
+using ::openpower::dump::utility::DumpType;
+
+/**
+ * @class SignalThread
+ * @brief Match and decode the dump signals on a thread of its own
+ * @details The dump entry signals are received on a D-Bus connection and
+ *  event loop owned by the thread, decoded into signal records and passed
+ *  to the offload engine on the main event loop through an event channel.
+ *  Decoding a flood of dump signals does not hold up the offload engine.
+ *  A single match per signal, restricted to the dump manager and the dump
+ *  namespace, receives the signals of all the dump types and the signal is
+ *  routed to its dump type by the entry object path.
+ */
+class SignalThread
+{
+  public:
+    SignalThread() = delete;
+    SignalThread(const SignalThread&) = delete;
+    SignalThread& operator=(const SignalThread&) = delete;
+    SignalThread(SignalThread&&) = delete;
+    SignalThread& operator=(SignalThread&&) = delete;
+    virtual ~SignalThread();
+
+    /** @brief Handler of the decoded signals, runs on the main event loop */
+    using Dispatch = std::function<void(const trace::Record&)>;
+
+    /**
+     * @brief Constructor
+     * @param[in] event - main event loop to dispatch the signals on
+     * @param[in] dispatch - handler of the decoded signals
+     */
+    SignalThread(sdeventplus::Event& event, Dispatch dispatch);
+
+    /**
+     * @brief Start the thread, returns once the signal matches are added
+     */
+    void start();
+
+    /**
+     * @struct Counters
+     * @brief Counts of the property change signals and of the work avoided
+     *        by decoding only the property of interest
+     */
+    struct Counters
+    {
+        /** @brief property change signals received */
+        uint64_t received;
+
+        /** @brief signals dropped without decoding any property value */
+        uint64_t decodesAvoided;
+
+        /** @brief signals not passed to the main event loop */
+        uint64_t wakeupsAvoided;
+    };
+
+    /**
+     * @brief Get the property change signal counters
+     * @return counters since the thread is created
+     */
+    Counters getCounters() const;
+
+  private:
+    /**
+     * @brief Thread body, runs the event loop of the thread
+     * @param[in] ready - set once the matches are added
+     */
+    void run(std::promise<void>& ready);
+
+    /** @brief matches on the dump signals */
+    using Matches = std::vector<std::unique_ptr<sdbusplus::bus::match_t>>;
+
+    /**
+     * @brief Add the matches on the dump signals
+     * @param[in] bus - D-Bus connection of the thread
+     * @param[out] matches - matches added to
+     */
+    void addMatches(sdbusplus::bus::bus& bus, Matches& matches);
+
+    /**
+     * @brief Get the key of the dump from the entry object path
+     * @param[in] path - D-Bus path of the dump entry object
+     * @return key of the dump, nullopt if not an entry of a dump type
+     */
+    std::optional<DumpKey> toDumpKey(const object_path& path) const;
+
+    /**
+     * @brief Decode the dump entry created signal
+     * @param[in] msg - signal
+     */
+    void interfaceAdded(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Decode the dump entry deleted signal
+     * @param[in] msg - signal
+     */
+    void interfaceRemoved(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Decode the progress property change signal
+     * @param[in] msg - signal
+     */
+    void progressChanged(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Decode the entry property change signal
+     * @param[in] msg - signal
+     */
+    void entryChanged(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Record the decoded signal and pass it to the main event loop
+     * @param[in] rec - decoded signal
+     */
+    void post(const trace::Record& rec);
+
+    /** @brief handler of the decoded signals */
+    Dispatch _dispatch;
+
+    /** @brief routes the entry object paths to the dump type */
+    const PathTrie _entryPaths;
+
+    /** @brief channel to the main event loop */
+    EventChannel _channel;
+
+    /** @brief guards the stop channel */
+    std::mutex _mutex;
+
+    /** @brief channel to stop the thread event loop, set while it runs */
+    EventChannel* _stopChannel = nullptr;
+
+    /** @brief event loop of the thread, set while it runs */
+    sdeventplus::Event* _threadEvent = nullptr;
+
+    /** @brief property change signals received */
+    std::atomic<uint64_t> _received = 0;
+
+    /** @brief signals dropped without decoding any property value */
+    std::atomic<uint64_t> _decodesAvoided = 0;
+
+    /** @brief signals not passed to the main event loop */
+    std::atomic<uint64_t> _wakeupsAvoided = 0;
+
+    /** @brief signal thread */
+    std::thread _thread;
+};
+} // namespace openpower::dump
@@ -0,0 +1,159 @@
+#include "signal_trace.hpp"
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace openpower::dump::trace
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+namespace
+{
+/** @brief trace file header, magic and the format version */
+constexpr std::array<char, 8> traceMagic = {'P', 'V', 'M', 'T',
+                                            'R', 'C', '0', '1'};
+
+/** @brief trace file being recorded, written by the signal thread and the
+ *  event loop thread, set once and never closed */
+std::atomic<int> traceFd = -1;
+
+/** @brief recording stopped on a write error, the file is left open as the
+ *  other thread may be writing to it */
+std::atomic<bool> isStopped = false;
+
+/** @brief time at which the recording started */
+std::chrono::steady_clock::time_point recordStart;
+} // namespace
+
+void initRecorder()
+{
+    const char* path = std::getenv("PVM_DUMP_OFFLOAD_TRACE");
+    if (path == nullptr || *path == '\0')
+    {
+        return;
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC,
+                  0644);
+    if (fd < 0)
+    {
+        logMsg<level::ERR>("Trace failed to open ({}) errno ({})", path,
+                           errno);
+        return;
+    }
+    if (write(fd, traceMagic.data(), traceMagic.size()) !=
+        static_cast<ssize_t>(traceMagic.size()))
+    {
+        logMsg<level::ERR>("Trace failed to write ({}) errno ({})", path,
+                           errno);
+        close(fd);
+        return;
+    }
+    recordStart = std::chrono::steady_clock::now();
+    traceFd = fd;
+    logMsg<level::INFO>("Trace recording signals to ({})", path);
+}
+
+bool isRecording()
+{
+    return traceFd >= 0 && !isStopped;
+}
+
+void record(Signal signal, DumpType type, uint32_t id, bool flag,
+            uint64_t value)
+{
+    int fd = traceFd;
+    if (fd < 0 || isStopped)
+    {
+        return;
+    }
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - recordStart);
+    Record rec{static_cast<uint64_t>(time.count()),
+               signal,
+               static_cast<uint8_t>(type),
+               flag,
+               0,
+               id,
+               value};
+    // a record per append, a crash loses at most the record being written
+    if (write(fd, &rec, sizeof(rec)) != sizeof(rec) &&
+        !isStopped.exchange(true))
+    {
+        logMsg<level::ERR>("Trace write failed errno ({}), recording stopped",
+                           errno);
+    }
+}
+
+Replayer::Replayer(sdeventplus::Event& event, const std::string& path,
+                   bool maxSpeed, Dispatch dispatch, Completion completion) :
+    _maxSpeed(maxSpeed),
+    _dispatch(std::move(dispatch)), _completion(std::move(completion)),
+    _timer(event, [this](Timer<Monotonic>&) { dispatchDue(); }),
+    _doneEvent(event, [this](sdeventplus::source::EventBase&) {
+        _completion();
+    })
+{
+    _doneEvent.set_priority(SD_EVENT_PRIORITY_IDLE);
+    _doneEvent.set_enabled(sdeventplus::source::Enabled::Off);
+
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, 8> magic{};
+    if (!file.read(magic.data(), magic.size()) || magic != traceMagic)
+    {
+        logMsg<level::ERR>("Trace ({}) is not a signal trace", path);
+        throw std::runtime_error("invalid signal trace");
+    }
+    Record rec{};
+    while (file.read(reinterpret_cast<char*>(&rec), sizeof(rec)))
+    {
+        _records.push_back(rec);
+    }
+    logMsg<level::INFO>("Trace ({}) loaded ({}) records", path,
+                        _records.size());
+}
+
+void Replayer::start()
+{
+    _startTime = std::chrono::steady_clock::now();
+    _next = 0;
+    _timer.restartOnce(std::chrono::microseconds(0));
+}
+
+void Replayer::dispatchDue()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startTime);
+    while (_next < _records.size())
+    {
+        const auto& rec = _records[_next];
+        auto due = std::chrono::microseconds(rec.time);
+        if (!_maxSpeed && due > elapsed)
+        {
+            _timer.restartOnce(due - elapsed);
+            return;
+        }
+        _dispatch(rec);
+        ++_next;
+        if (_maxSpeed)
+        {
+            // let the event sources run in between the records
+            _timer.restartOnce(std::chrono::microseconds(0));
+            return;
+        }
+    }
+    logMsg<level::INFO>("Trace replayed ({}) records in ({}) ms",
+                        _records.size(), elapsed.count() / 1000);
+    _doneEvent.set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+} // namespace openpower::dump::trace
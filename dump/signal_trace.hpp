@@ -0,0 +1,159 @@
+#pragma once
+
+#include "dump_key.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <string>
+#include <vector>
+
+namespace openpower::dump::trace
+{
+using ::sdeventplus::ClockId::Monotonic;
+using ::sdeventplus::utility::Timer;
+
+/** @brief Signal consumed by the daemon, decoded */
+enum class Signal : uint8_t
+{
+    dumpAdded,
+    dumpRemoved,
+    dumpCompleted,
+    dumpOffloaded,
+    hostState,
+    hmcState
+};
+
+/**
+ * @struct Record
+ * @brief Record of a decoded signal, passed from the signal thread to the
+ *        offload engine and written to the trace
+ * @details flag is the dump completed state for dumpAdded, running state
+ *          for hostState and HMC managed state for hmcState. value is the
+ *          size of the dump for dumpAdded.
+ */
+struct Record
+{
+    /** @brief microseconds since the start of the recording */
+    uint64_t time;
+
+    /** @brief signal decoded */
+    Signal signal;
+
+    /** @brief DumpType of the dump, for the dump signals */
+    uint8_t type;
+
+    /** @brief state carried by the signal */
+    bool flag;
+
+    /** @brief reserved, written as 0 */
+    uint8_t reserved;
+
+    /** @brief id of the dump, for the dump signals */
+    uint32_t id;
+
+    /** @brief value carried by the signal */
+    uint64_t value;
+};
+
+/** @brief Records are written to the trace file as is, host byte order */
+static_assert(sizeof(Record) == 24, "trace record layout changed");
+
+/**
+ * @brief Start recording if PVM_DUMP_OFFLOAD_TRACE names a trace file
+ */
+void initRecorder();
+
+/**
+ * @brief Check if the signals are being recorded
+ * @return true if recording
+ */
+bool isRecording();
+
+/**
+ * @brief Record the decoded signal, no-op if not recording
+ * @param[in] signal - signal decoded
+ * @param[in] type - type of the dump
+ * @param[in] id - id of the dump
+ * @param[in] flag - state carried by the signal
+ * @param[in] value - value carried by the signal
+ */
+void record(Signal signal, DumpType type = DumpType::bmc, uint32_t id = 0,
+            bool flag = false, uint64_t value = 0);
+
+/**
+ * @class Replayer
+ * @brief Feed the records of a trace file to the signal handlers
+ * @details Records are dispatched at the recorded time offsets or back to
+ *  back at max speed, one record per event loop iteration so that the
+ *  event sources of the daemon are run in between as for the live signals.
+ *  Completion is invoked at idle priority, after the work triggered by the
+ *  last record is done.
+ */
+class Replayer
+{
+  public:
+    Replayer() = delete;
+    Replayer(const Replayer&) = delete;
+    Replayer& operator=(const Replayer&) = delete;
+    Replayer(Replayer&&) = delete;
+    Replayer& operator=(Replayer&&) = delete;
+    virtual ~Replayer() = default;
+
+    /** @brief Handler of the replayed records */
+    using Dispatch = std::function<void(const Record&)>;
+
+    /** @brief Invoked once all the records are dispatched */
+    using Completion = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param[in] event - event handler
+     * @param[in] path - trace file to replay
+     * @param[in] maxSpeed - ignore the recorded time offsets
+     * @param[in] dispatch - handler of the records
+     * @param[in] completion - invoked once the trace is replayed
+     */
+    Replayer(sdeventplus::Event& event, const std::string& path,
+             bool maxSpeed, Dispatch dispatch, Completion completion);
+
+    /**
+     * @brief Start the replay
+     */
+    void start();
+
+  private:
+    /**
+     * @brief Dispatch the records due and schedule the next one
+     */
+    void dispatchDue();
+
+    /** @brief records read from the trace file */
+    std::vector<Record> _records;
+
+    /** @brief next record to dispatch */
+    size_t _next = 0;
+
+    /** @brief ignore the recorded time offsets */
+    bool _maxSpeed;
+
+    /** @brief handler of the records */
+    Dispatch _dispatch;
+
+    /** @brief invoked once the trace is replayed */
+    Completion _completion;
+
+    /** @brief time at which the replay started */
+    std::chrono::steady_clock::time_point _startTime;
+
+    /** @brief timer to dispatch the next record */
+    Timer<Monotonic> _timer;
+
+    /** @brief idle priority event to invoke the completion */
+    sdeventplus::source::Defer _doneEvent;
+};
+} // namespace openpower::dump::trace
@@ -0,0 +1,161 @@
+#include "config.h"
+
+#include "storage_watch.hpp"
+
+#include "logging.hpp"
+
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+/** @brief events on the top level dump directories, dumps created/deleted */
+constexpr uint32_t dumpDirEvents =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+/** @brief events on the dump entry directories, dump files written */
+constexpr uint32_t entryDirEvents = IN_CLOSE_WRITE | IN_DELETE | IN_ONLYDIR;
+
+StorageWatch::StorageWatch(sdeventplus::Event& event,
+                           HostOffloaderQueue& dumpQueue) :
+    _dumpQueue(dumpQueue),
+    _dumpDirs{bmcDumpFilePath, hostbootDumpFilePath, sbeDumpFilePath,
+              hardwareDumpFilePath}
+{
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotifyFd < 0)
+    {
+        logMsg<level::ERR>("Storage failed to initialize inotify errno ({})",
+                           errno);
+        return;
+    }
+    for (const auto& dir : _dumpDirs)
+    {
+        addWatch(dir, true);
+        std::error_code ec;
+        for (const auto& entry :
+             std::filesystem::directory_iterator(dir, ec))
+        {
+            if (entry.is_directory(ec))
+            {
+                addWatch(entry.path().string(), false);
+            }
+        }
+    }
+    _inotifySource = std::make_unique<sdeventplus::source::IO>(
+        event, _inotifyFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int fd, uint32_t revents) {
+            this->inotifyEvent(fd, revents);
+        });
+
+    checkFreeSpace();
+}
+
+StorageWatch::~StorageWatch()
+{
+    _inotifySource.reset();
+    if (_inotifyFd >= 0)
+    {
+        close(_inotifyFd);
+    }
+}
+
+void StorageWatch::addWatch(const std::string& path, bool isDumpDir)
+{
+    int wd = inotify_add_watch(_inotifyFd, path.c_str(),
+                               isDumpDir ? dumpDirEvents : entryDirEvents);
+    if (wd < 0)
+    {
+        logMsg<level::INFO>("Storage failed to watch ({}) errno ({})", path,
+                            errno);
+        return;
+    }
+    if (isDumpDir)
+    {
+        _dumpDirWatches.emplace(wd, path);
+    }
+}
+
+void StorageWatch::inotifyEvent(int fd, uint32_t /*revents*/)
+{
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    bool changed = false;
+    while (true)
+    {
+        auto len = read(fd, buffer.data(), buffer.size());
+        if (len <= 0)
+        {
+            // EAGAIN, all the events are read
+            break;
+        }
+        for (ssize_t offset = 0; offset < len;)
+        {
+            auto event = reinterpret_cast<inotify_event*>(&buffer[offset]);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_IGNORED)
+            {
+                continue;
+            }
+            changed = true;
+
+            // new dump entry directory, watch for the dump files written
+            auto dir = _dumpDirWatches.find(event->wd);
+            if (dir != _dumpDirWatches.end() && (event->mask & IN_ISDIR) &&
+                (event->mask & (IN_CREATE | IN_MOVED_TO)) && event->len > 0)
+            {
+                addWatch(dir->second + "/" + event->name, false);
+            }
+        }
+    }
+    // check once for all the events read
+    if (changed)
+    {
+        checkFreeSpace();
+    }
+}
+
+void StorageWatch::checkFreeSpace()
+{
+    // lowest free space percentage of the dump file systems
+    uint64_t freePercent = 100;
+    for (const auto& dir : _dumpDirs)
+    {
+        struct statvfs stat = {};
+        if (statvfs(dir.c_str(), &stat) != 0 || stat.f_blocks == 0)
+        {
+            continue;
+        }
+        uint64_t percent = (static_cast<uint64_t>(stat.f_bavail) * 100) /
+                           static_cast<uint64_t>(stat.f_blocks);
+        freePercent = std::min(freePercent, percent);
+    }
+
+    bool isLowSpace = _isLowSpace;
+    if (!_isLowSpace && freePercent < storageLowWatermarkPercent)
+    {
+        isLowSpace = true;
+    }
+    else if (_isLowSpace && freePercent >= storageHighWatermarkPercent)
+    {
+        isLowSpace = false;
+    }
+    if (isLowSpace != _isLowSpace)
+    {
+        logMsg<level::INFO>("Storage dump free space ({}) percent low ({})",
+                            freePercent, isLowSpace);
+        _isLowSpace = isLowSpace;
+        _dumpQueue.storageStateChange(_isLowSpace);
+    }
+}
+} // namespace openpower::dump
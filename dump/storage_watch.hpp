@@ -0,0 +1,79 @@
+#pragma once
+
+#include "host_offloader_queue.hpp"
+
+#include <map>
+#include <memory>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <string>
+#include <vector>
+
+namespace openpower::dump
+{
+
+/**
+ * @class StorageWatch
+ * @brief Add watch on the dump storage free space to prioritise offload
+ * @details Dump directories are watched using inotify, free space is checked
+ *  when dumps are created or deleted. When free space falls below the low
+ *  watermark the queue is notified to offload largest dumps first, normal
+ *  order is restored once free space is above the high watermark.
+ */
+class StorageWatch
+{
+  public:
+    StorageWatch() = delete;
+    StorageWatch(const StorageWatch&) = delete;
+    StorageWatch& operator=(const StorageWatch&) = delete;
+    StorageWatch(StorageWatch&&) = delete;
+    StorageWatch& operator=(StorageWatch&&) = delete;
+    virtual ~StorageWatch();
+
+    /**
+     * @brief Watch on dump storage
+     * @param[in] event - event handler
+     * @param[in] dumpQueue - dump queue
+     */
+    StorageWatch(sdeventplus::Event& event, HostOffloaderQueue& dumpQueue);
+
+    /**
+     * @brief Check the free space of the dump storage and notify the queue
+     *        if the state changed
+     */
+    void checkFreeSpace();
+
+  private:
+    /**
+     * @brief Add watch on the directory
+     * @param[in] path - path of the directory
+     * @param[in] isDumpDir - True if top level dump directory
+     */
+    void addWatch(const std::string& path, bool isDumpDir);
+
+    /**
+     * @brief Callback method for the inotify events
+     * @param[in] fd - inotify file descriptor
+     * @param[in] revents - events returned by epoll
+     */
+    void inotifyEvent(int fd, uint32_t revents);
+
+    /** @brief Queue to offload dump requests */
+    HostOffloaderQueue& _dumpQueue;
+
+    /** @brief top level dump directories */
+    std::vector<std::string> _dumpDirs;
+
+    /** @brief inotify watch descriptors of the top level dump directories */
+    std::map<int, std::string> _dumpDirWatches;
+
+    /** @brief inotify file descriptor */
+    int _inotifyFd = -1;
+
+    /** @brief event source of the inotify file descriptor */
+    std::unique_ptr<sdeventplus::source::IO> _inotifySource;
+
+    /** @brief Flag to indicate whether the dump storage is low */
+    bool _isLowSpace = false;
+};
+} // namespace openpower::dump
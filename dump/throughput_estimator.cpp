@@ -0,0 +1,81 @@
+#include "throughput_estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace openpower::dump
+{
+
+/** @brief weight of a new sample in the average rate */
+constexpr auto rateGain = 1.0 / 8;
+
+/** @brief weight of a new sample in the mean deviation */
+constexpr auto deviationGain = 1.0 / 4;
+
+/** @brief samples farther than this many deviations are outliers */
+constexpr auto outlierDeviations = 3.0;
+
+/** @brief deviation is at least this fraction of the rate */
+constexpr auto minDeviationRatio = 0.1;
+
+/** @brief samples accepted before the outliers are rejected */
+constexpr auto warmupSamples = 3;
+
+/** @brief outliers in a row taken as a change of the throughput */
+constexpr auto maxConsecutiveRejects = 3;
+
+ThroughputEstimator::ThroughputEstimator(uint64_t initialRate) :
+    _rate(static_cast<double>(initialRate))
+{
+}
+
+bool ThroughputEstimator::sample(uint64_t bytes,
+                                 std::chrono::milliseconds duration)
+{
+    // transfers are timed with a millisecond resolution
+    double rate = static_cast<double>(bytes) * 1000 /
+                  static_cast<double>(std::max<int64_t>(duration.count(), 1));
+    if (_sampleCount == 0)
+    {
+        _rate = rate;
+        _deviation = rate / 2;
+        _sampleCount = 1;
+        return true;
+    }
+
+    double error = rate - _rate;
+    double deviation = std::max(_deviation, _rate * minDeviationRatio);
+    if (_sampleCount >= warmupSamples &&
+        std::abs(error) > outlierDeviations * deviation)
+    {
+        if (++_consecutiveRejects < maxConsecutiveRejects)
+        {
+            ++_rejectedCount;
+            return false;
+        }
+        // throughput has changed, restart from the new rate
+        _consecutiveRejects = 0;
+        _rate = rate;
+        _deviation = rate / 2;
+        _sampleCount = 1;
+        return true;
+    }
+    _consecutiveRejects = 0;
+    _rate += rateGain * error;
+    _deviation += deviationGain * (std::abs(error) - _deviation);
+    ++_sampleCount;
+    return true;
+}
+
+uint64_t ThroughputEstimator::getRate() const
+{
+    return static_cast<uint64_t>(std::max(_rate, 1.0));
+}
+
+std::chrono::milliseconds
+    ThroughputEstimator::getTransferTime(uint64_t bytes) const
+{
+    return std::chrono::milliseconds(static_cast<int64_t>(
+        static_cast<double>(bytes) * 1000 / std::max(_rate, 1.0)));
+}
+} // namespace openpower::dump
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace openpower::dump
+{
+
+/**
+ * @class ThroughputEstimator
+ * @brief Online estimate of the rate at which the host pulls the dumps
+ * @details Exponentially weighted moving average of the observed rates
+ *  along with the mean deviation. Once warmed up a sample too far from the
+ *  average is rejected as an outlier, unless several samples in a row are
+ *  rejected which is taken as a change of the link throughput.
+ */
+class ThroughputEstimator
+{
+  public:
+    ThroughputEstimator() = delete;
+    ThroughputEstimator(const ThroughputEstimator&) = delete;
+    ThroughputEstimator& operator=(const ThroughputEstimator&) = delete;
+    ThroughputEstimator(ThroughputEstimator&&) = delete;
+    ThroughputEstimator& operator=(ThroughputEstimator&&) = delete;
+    virtual ~ThroughputEstimator() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] initialRate - rate assumed until the first sample, bytes
+     *                          per second
+     */
+    explicit ThroughputEstimator(uint64_t initialRate);
+
+    /**
+     * @brief Add an observed transfer
+     * @param[in] bytes - size of the dump transferred
+     * @param[in] duration - time from announcement to completion
+     * @return false if the sample is rejected as an outlier
+     */
+    bool sample(uint64_t bytes, std::chrono::milliseconds duration);
+
+    /**
+     * @brief Get the estimated rate
+     * @return bytes per second
+     */
+    uint64_t getRate() const;
+
+    /**
+     * @brief Get the time expected to transfer the bytes
+     * @param[in] bytes - size to transfer
+     * @return expected transfer time
+     */
+    std::chrono::milliseconds getTransferTime(uint64_t bytes) const;
+
+    /**
+     * @brief Get the number of samples rejected as outliers
+     * @return rejected sample count
+     */
+    size_t getRejectedCount() const
+    {
+        return _rejectedCount;
+    }
+
+  private:
+    /** @brief average rate, bytes per second */
+    double _rate;
+
+    /** @brief mean deviation of the rate */
+    double _deviation = 0;
+
+    /** @brief number of samples accepted */
+    size_t _sampleCount = 0;
+
+    /** @brief number of samples rejected */
+    size_t _rejectedCount = 0;
+
+    /** @brief number of samples rejected in a row */
+    size_t _consecutiveRejects = 0;
+};
+} // namespace openpower::dump
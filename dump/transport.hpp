@@ -0,0 +1,75 @@
+#pragma once
+
+#include "dump_key.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace openpower::dump
+{
+
+/**
+ * @class TransportError
+ * @brief Announcement failed on the transport
+ * @details Raised when the request could not reach the host because of the
+ *  transport, as against the errors specific to the dump announced.
+ */
+class TransportError : public std::runtime_error
+{
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @class Transport
+ * @brief Transport announcing the dumps to the host
+ * @details The offload engine is independent of how the host is reached,
+ *  the standalone daemon announces over PLDM through pldmd while a process
+ *  owning the PLDM endpoint can announce directly.
+ */
+class Transport
+{
+  public:
+    Transport() = default;
+    Transport(const Transport&) = delete;
+    Transport& operator=(const Transport&) = delete;
+    Transport(Transport&&) = delete;
+    Transport& operator=(Transport&&) = delete;
+    virtual ~Transport() = default;
+
+    /**
+     * @brief Announce the dump to the host
+     * @details Called on a worker thread, one announcement at a time, the
+     *          call may block.
+     * @throws TransportError if the request could not reach the host
+     * @throws std::exception on an error specific to the dump
+     * @param[in] key - key of the dump
+     * @param[in] size - size of the dump announced
+     */
+    virtual void announce(const DumpKey& key, uint64_t size) = 0;
+};
+
+/**
+ * @class NullTransport
+ * @brief Transport not reaching the host
+ * @details Used to replay a signal trace, the offload of the dumps
+ *  announced is completed by the signals replayed from the trace.
+ */
+class NullTransport : public Transport
+{
+  public:
+    NullTransport() = default;
+    NullTransport(const NullTransport&) = delete;
+    NullTransport& operator=(const NullTransport&) = delete;
+    NullTransport(NullTransport&&) = delete;
+    NullTransport& operator=(NullTransport&&) = delete;
+    virtual ~NullTransport() = default;
+
+    /**
+     * @brief Announcement is dropped
+     * @param[in] key - key of the dump
+     * @param[in] size - size of the dump announced
+     */
+    void announce(const DumpKey& /*key*/, uint64_t /*size*/) override {}
+};
+} // namespace openpower::dump
@@ -0,0 +1,82 @@
+#include "worker_pool.hpp"
+
+#include "logging.hpp"
+
+#include <algorithm>
+
+namespace openpower::dump
+{
+using ::openpower::dump::logging::logMsg;
+using ::phosphor::logging::level;
+
+WorkerPool::WorkerPool(sdeventplus::Event& event, size_t threads) :
+    _completions(event)
+{
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+    {
+        _threads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _jobReady.notify_all();
+    for (auto& thread : _threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+void WorkerPool::post(Job job, Completion completion, bool urgent)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (urgent)
+        {
+            _jobs.emplace_front(std::move(job), std::move(completion));
+        }
+        else
+        {
+            _jobs.emplace_back(std::move(job), std::move(completion));
+        }
+    }
+    _jobReady.notify_one();
+}
+
+void WorkerPool::run()
+{
+    while (true)
+    {
+        std::pair<Job, Completion> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobReady.wait(lock, [this] { return _stop || !_jobs.empty(); });
+            if (_stop)
+            {
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        try
+        {
+            job.first();
+        }
+        catch (const std::exception& ex)
+        {
+            logMsg<level::ERR>("Worker job failed ({})", ex.what());
+        }
+        if (job.second)
+        {
+            _completions.post(std::move(job.second));
+        }
+    }
+}
+} // namespace openpower::dump
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "event_channel.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sdeventplus/event.hpp>
+#include <thread>
+#include <vector>
+
+namespace openpower::dump
+{
+
+/**
+ * @class WorkerPool
+ * @brief Run blocking jobs off the event loop
+ * @details Jobs are run on a small pool of worker threads, completion of
+ *  the job is invoked on the event loop thread through the event channel.
+ */
+class WorkerPool
+{
+  public:
+    WorkerPool() = delete;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+    virtual ~WorkerPool();
+
+    /** @brief Job run on a worker thread */
+    using Job = std::function<void()>;
+
+    /** @brief Completion run on the event loop once the job is done */
+    using Completion = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param[in] event - event handler to post the completions to
+     * @param[in] threads - number of worker threads
+     */
+    WorkerPool(sdeventplus::Event& event, size_t threads);
+
+    /**
+     * @brief Queue the job to run on a worker thread
+     * @param[in] job - job to run on the worker thread
+     * @param[in] completion - invoked on the event loop when job is done
+     * @param[in] urgent - run ahead of the jobs already queued
+     */
+    void post(Job job, Completion completion, bool urgent = false);
+
+  private:
+    /** @brief worker thread loop */
+    void run();
+
+    /** @brief guards the job queue */
+    std::mutex _mutex;
+
+    /** @brief signalled when a job is queued or on stop */
+    std::condition_variable _jobReady;
+
+    /** @brief jobs to run */
+    std::deque<std::pair<Job, Completion>> _jobs;
+
+    /** @brief set to stop the worker threads */
+    bool _stop = false;
+
+    /** @brief channel to post the completions to the event loop */
+    EventChannel _completions;
+
+    /** @brief worker threads */
+    std::vector<std::thread> _threads;
+};
+} // namespace openpower::dump